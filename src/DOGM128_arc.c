@@ -41,27 +41,7 @@ const uint8_t dog_sin_table[] =
 /* FUNCTIONS                                                                  */
 /*----------------------------------------------------------------------------*/
 
-/** This function is used to compute an integer-justified sine value for the
- *  provided angle (in LCD_angles). This function should only be needed by the
- *  dogm128, hence it has been made static (of course that can be changed 
- *  according to course material).
- *
- *
- *  @par Parameters
- *    - @a angle = The angle whose sine value must be computed.
- *
- *  @par Algorithm
- *       - Pulls data from the constant sine table based upon the provided angle
- *       - Since the table only covers one quarter of the total sine wave, 
- *         sine values are flipped and negated according to the symmetry of the
- *         sine wave. This is exactly the same method used in both ESE 381
- *         and ESE 382 during the Spring 2013 semester.
- *
- *  @par Assumptions
- *       - None
- *
- */
-static int8_t dog_sin(uint8_t angle)
+int8_t dog_sin(uint8_t angle)
 {
   uint8_t case_angle = (angle>>6)&3;
   uint8_t angle_index = angle & 63;
@@ -84,24 +64,7 @@ static int8_t dog_sin(uint8_t angle)
   return result;
 }
 
-/** This function is used to compute an integer-justified cosine value for the
- *  provided angle (in LCD_angles). This function should only be needed by the
- *  dogm128, hence it has been made static(of course that can be changed 
- *  according to course material).
- *
- *  @par Parameters
- *    - @a angle = The angle whose cosine value must be computed.
- *
- *  @par Algorithm
- *       - Simply calls the dog_sin() function in this file, providing it with
- *         @a angle shifted 90 degrees because a cosine wave is the same thing 
- *         as a sine wave shifted 90 degrees.
- *
- *  @par Assumptions
- *       - None
- *
- */
-static int8_t dog_cos(uint8_t angle)
+int8_t dog_cos(uint8_t angle)
 {
   return dog_sin( (angle+64U) );
 }
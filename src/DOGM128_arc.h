@@ -10,7 +10,8 @@
  * @{
  *
  * This file contains the prototype for the dog_draw_arc() function, 
- * which is used to set or clear an arc or unfilled circle.
+ * which is used to set or clear an arc or unfilled circle, along with the
+ * fast sine and cosine functions it is built on.
  *
  */
 
@@ -19,10 +20,53 @@
 /*----------------------------------------------------------------------------*/
 #include "DOGM128_common.h"
 
+/*----------------------------------------------------------------------------*/
+/* EXTERNAL DATA                                                              */
+/*----------------------------------------------------------------------------*/
+/** Sine from 0 to 90 degrees in 65 steps, scaled so that 64 is 1.0 */
+extern const uint8_t dog_sin_table[];
+
 /*----------------------------------------------------------------------------*/
 /* FUNCTIONS                                                                  */
 /*----------------------------------------------------------------------------*/
 
+/** This function is used to compute an integer-justified sine value for the
+ *  provided angle (in LCD_angles, see dog_draw_arc()), scaled so that 64 is
+ *  1.0.
+ *
+ *  @par Parameters
+ *    - @a angle = The angle whose sine value must be computed.
+ *
+ *  @par Algorithm
+ *       - Pulls data from the constant sine table based upon the provided angle
+ *       - Since the table only covers one quarter of the total sine wave, 
+ *         sine values are flipped and negated according to the symmetry of the
+ *         sine wave. This is exactly the same method used in both ESE 381
+ *         and ESE 382 during the Spring 2013 semester.
+ *
+ *  @par Assumptions
+ *       - None
+ *
+ */
+int8_t dog_sin(uint8_t angle);
+
+/** This function is used to compute an integer-justified cosine value for the
+ *  provided angle (in LCD_angles), scaled so that 64 is 1.0.
+ *
+ *  @par Parameters
+ *    - @a angle = The angle whose cosine value must be computed.
+ *
+ *  @par Algorithm
+ *       - Simply calls the dog_sin() function, providing it with @a angle
+ *         shifted 90 degrees because a cosine wave is the same thing as a
+ *         sine wave shifted 90 degrees.
+ *
+ *  @par Assumptions
+ *       - None
+ *
+ */
+int8_t dog_cos(uint8_t angle);
+
 /** This function is used set or clear an arc or unfilled circle of thickness 0
  *  or 1. If both the start and end angle are the same number, then a circle 
  *  is drawn.
@@ -0,0 +1,182 @@
+/*
+ * @file   DOGM128_bar.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for bar graphs on the EA DOGM128. <br>
+ * @defgroup DOGM128_bar_source
+ * @{
+ *
+ * This file contains the source code for the functions described in
+ * bar.h. The user should include this file, along with rectangle.c, in his
+ * or her project should they choose to use bar graphs.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_bar.h"
+#include "DOGM128_rectangle.h"
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to set or clear a stretch of a bar and extend the
+ *  rewritten region to include it.
+ *
+ *  @par Parameters
+ *    - @a bar   = The bar.
+ *    - @a start = Offset of the first pixel along the bar.
+ *    - @a end   = Offset of the last pixel along the bar.
+ *    - @a mode  = 's' to fill or 'c' to clear.
+ *    - @a span  = Region rewritten so far; extended to cover the stretch.
+ */
+static void dog_bar_stretch(const dog_bar_t *bar, uint8_t start, uint8_t end,
+                            char mode, dog_span_t *span)
+{
+  uint8_t x1, y1, x2, y2;
+
+  if(bar->flags & DOG_BAR_VERTICAL)
+  {
+    /* Offsets count up from the bottom row */
+    x1 = bar->x;
+    x2 = bar->x + bar->width - 1;
+    y1 = bar->y + bar->height - 1 - end;
+    y2 = bar->y + bar->height - 1 - start;
+  }
+  else
+  {
+    x1 = bar->x + start;
+    x2 = bar->x + end;
+    y1 = bar->y;
+    y2 = bar->y + bar->height - 1;
+  }
+
+  dog_fill_rectangle(x1, y1, x2, y2, mode);
+
+  if((y1 >> 3) < span->page_start) span->page_start = y1 >> 3;
+  if((y2 >> 3) > span->page_end)   span->page_end = y2 >> 3;
+  if(x1 < span->col_start)         span->col_start = x1;
+  if(x2 > span->col_end)           span->col_end = x2;
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int8_t dog_bar_init(dog_bar_t *bar,
+                    uint8_t x,
+                    uint8_t y,
+                    uint8_t width,
+                    uint8_t height,
+                    uint16_t max,
+                    uint8_t segments,
+                    uint8_t gap,
+                    uint8_t flags)
+{
+  uint8_t inset = (flags & DOG_BAR_FRAME) ? 2 : 0;
+  uint8_t length;
+
+  /* Ensure the whole bar fits on the display */
+  if(x >= DOG_WIDTH || y >= DOG_HEIGHT || max == 0) return -1;
+  if(width > DOG_WIDTH - x || height > DOG_HEIGHT - y) return -1;
+  if(width <= 2*inset || height <= 2*inset) return -1;
+
+  bar->x = x + inset;
+  bar->y = y + inset;
+  bar->width = width - 2*inset;
+  bar->height = height - 2*inset;
+  bar->flags = flags;
+  bar->max = max;
+
+  length = (flags & DOG_BAR_VERTICAL) ? bar->height : bar->width;
+  if(segments)
+  {
+    /* Each segment and the gap after it; the last gap may hang off the end */
+    if(segments > length) return -1;
+    bar->pitch = (length + gap) / segments;
+    if(bar->pitch <= gap) return -1;
+    bar->units = segments;
+    bar->gap = gap;
+  }
+  else
+  {
+    bar->pitch = 1;
+    bar->units = length;
+    bar->gap = 0;
+  }
+
+  dog_bar_invalidate(bar);
+  return 0;
+}
+
+uint8_t dog_bar_update(dog_bar_t *bar, uint16_t value, dog_span_t *span)
+{
+  dog_span_t region = { DOG_PAGE_HEIGHT, 0, DOG_WIDTH, 0 };
+  uint8_t target, unit, changed;
+
+  if(value > bar->max) value = bar->max;
+  target = (uint32_t)value * bar->units / bar->max;
+
+  if(bar->shown == DOG_BAR_UNKNOWN)
+  {
+    /* Start from an empty bar */
+    if(bar->flags & DOG_BAR_FRAME)
+    {
+      dog_fill_rectangle(bar->x - 1, bar->y - 1, bar->x + bar->width,
+                         bar->y + bar->height, 'c');
+      dog_draw_rectangle(bar->x - 2, bar->y - 2, bar->x + bar->width + 1,
+                         bar->y + bar->height + 1, 0, 's');
+      region.page_start = (bar->y - 2) >> 3;
+      region.page_end = (bar->y + bar->height + 1) >> 3;
+      region.col_start = bar->x - 2;
+      region.col_end = bar->x + bar->width + 1;
+    }
+    else
+    {
+      dog_bar_stretch(bar, 0, ((bar->flags & DOG_BAR_VERTICAL) ?
+                               bar->height : bar->width) - 1, 'c', &region);
+    }
+    bar->shown = 0;
+    changed = bar->units;
+  }
+  else if(target != bar->shown)
+  {
+    changed = (target > bar->shown) ? target - bar->shown : bar->shown - target;
+  }
+  else
+  {
+    return 0;
+  }
+
+  if(target > bar->shown && bar->gap)
+  {
+    /* Fill segment by segment so that the gaps stay clear */
+    for(unit = bar->shown; unit < target; ++unit)
+      dog_bar_stretch(bar, unit * bar->pitch,
+                      (unit + 1) * bar->pitch - bar->gap - 1, 's', &region);
+  }
+  else if(target > bar->shown)
+  {
+    dog_bar_stretch(bar, bar->shown * bar->pitch,
+                    target * bar->pitch - 1, 's', &region);
+  }
+  else if(target < bar->shown)
+  {
+    /* The gaps are clear already, so one rectangle covers the segments */
+    dog_bar_stretch(bar, target * bar->pitch,
+                    bar->shown * bar->pitch - bar->gap - 1, 'c', &region);
+  }
+  bar->shown = target;
+
+  if(span) *span = region;
+  return changed;
+}
+
+void dog_bar_invalidate(dog_bar_t *bar)
+{
+  bar->shown = DOG_BAR_UNKNOWN;
+}
+
+/* @} */ /* DOGM128_bar_source */
@@ -0,0 +1,129 @@
+/**
+ * @file   DOGM128_bar.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Header file for bar graphs on the EA DOGM128. <br>
+ * @defgroup DOGM128_bar Bar Graphs
+ * @{
+ *
+ * This file contains function prototypes for bar graphs, progress bars and
+ * segmented level meters. A bar remembers how far it is filled on the
+ * screen, so a new value only fills or clears the columns (or rows, for a
+ * vertical bar) between the old and the new level, using
+ * dog_fill_rectangle(). A meter moving by one step costs a few bytes of the
+ * buffer and leaves only that strip dirty.
+ *
+ * A bar is divided into units: pixels for a continuous bar, or segments
+ * for a level meter. Segments are separated by a clear gap.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_BAR_H
+#define DOGM128_BAR_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Bar flag: fill from the bottom up instead of from left to right */
+#define DOG_BAR_VERTICAL  0x01
+/** Bar flag: draw an outline around the bar, with a clear pixel in between,
+ *  as for a progress bar */
+#define DOG_BAR_FRAME     0x02
+
+/** Value of the @a shown member while the screen contents are unknown */
+#define DOG_BAR_UNKNOWN   0xFF
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** used to store the state of a bar between updates */
+typedef struct
+{
+  uint8_t x;                /**< left-hand column of the filled area      */
+  uint8_t y;                /**< top row of the filled area               */
+  uint8_t width;            /**< width of the filled area in pixels       */
+  uint8_t height;           /**< height of the filled area in pixels      */
+  uint8_t flags;            /**< DOG_BAR_* flags                          */
+  uint8_t units;            /**< segments, or pixels of a continuous bar  */
+  uint8_t pitch;            /**< pixels from one unit to the next         */
+  uint8_t gap;              /**< clear pixels between two segments        */
+  uint16_t max;             /**< value at which the bar is full           */
+  uint8_t shown;            /**< units currently filled on the screen     */
+} dog_bar_t;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to set up a bar. Nothing is drawn until the first
+ *  call to dog_bar_update().
+ *
+ *  @par Parameters
+ *         - @a bar      = The bar to be set up.
+ *         - @a x        = Left-hand column of the bar, including any frame.
+ *         - @a y        = Top row of the bar, including any frame.
+ *         - @a width    = Width of the bar in pixels, including any frame.
+ *         - @a height   = Height of the bar in pixels, including any frame.
+ *         - @a max      = Value at which the bar is full [1,65535].
+ *         - @a segments = Number of segments of a level meter, or 0 for a
+ *                         continuous bar.
+ *         - @a gap      = Clear pixels between two segments.
+ *         - @a flags    = Any combination of @b DOG_BAR_VERTICAL and
+ *                         @b DOG_BAR_FRAME.
+ *
+ *  @par Assumptions
+ *       - None
+ *
+ *  @returns Upon successful completion, the function returns zero. It returns
+ *           -1 if the bar does not fit on the display, or if the segments and
+ *           gaps do not fit in the bar.
+ */
+int8_t dog_bar_init(dog_bar_t *bar,
+                    uint8_t x,
+                    uint8_t y,
+                    uint8_t width,
+                    uint8_t height,
+                    uint16_t max,
+                    uint8_t segments,
+                    uint8_t gap,
+                    uint8_t flags);
+
+/** This function is used to display a new value in a bar.
+ *
+ *  @par Parameters
+ *         - @a bar   = The bar to be updated.
+ *         - @a value = The new value [0,max]; larger values fill the bar.
+ *         - @a span  = Optional (may be NULL). Receives the region of the
+ *                      buffer that was rewritten.
+ *
+ *  @par Algorithm
+ *       The value is scaled to a number of units. If the bar grew, the new
+ *       units are filled one segment at a time, so the gaps stay clear; if
+ *       it shrank, the units given up are cleared in a single rectangle.
+ *       After dog_bar_init() or dog_bar_invalidate(), the bar is first
+ *       cleared and its frame drawn.
+ *
+ *  @par Assumptions
+ *       - Nothing else draws over the bar. If it does, call
+ *         dog_bar_invalidate() to force a full redraw.
+ *       - The orientation is one of the landscape modes.
+ *
+ *  @returns The number of units redrawn; every unit of the bar when it was
+ *           redrawn in full. @a span is only written when this is non-zero.
+ */
+uint8_t dog_bar_update(dog_bar_t *bar, uint16_t value, dog_span_t *span);
+
+/** This function is used to force the whole bar to be redrawn on the next
+ *  call to dog_bar_update().
+ */
+void dog_bar_invalidate(dog_bar_t *bar);
+
+#endif /* DOGM128_BAR_H */
+/** @} */ /* DOGM128_bar */
@@ -28,11 +28,11 @@
 /* EXTERNAL DATA                                                              */
 /*----------------------------------------------------------------------------*/
 /**
- * @var uint8_t dog_buffer[DOG_PAGE_HEIGHT][DOG_WIDTH]
+ * @var uint8_t (*dog_buffer)[DOG_WIDTH]
  * @brief External buffer used for storing screen contents before sending data
- *        to screen.
+ *        to screen (the current draw target).
  */
-extern uint8_t dog_buffer[DOG_PAGE_HEIGHT][DOG_WIDTH];
+extern uint8_t (*dog_buffer)[DOG_WIDTH];
 
 /*----------------------------------------------------------------------------*/
 /* CONSTANTS                                                                  */
@@ -143,6 +143,77 @@ const unsigned char dog_character_set[] =
         0x06, 0x1E, 0x1C, 0x1E, 0x06, //Surprise
 };
 
+/**
+ * @var const uint16_t dog_extended_code_points[]
+ * @brief Sorted list of the Unicode code points, outside of the range covered
+ *        by dog_character_set[], for which a bitmap is available. Only
+ *        characters listed here take up space, and since the list is sorted 
+ *        a character can be found with a binary search.
+ */
+const uint16_t dog_extended_code_points[] =
+{
+  0x00B0, 0x00B1, 0x00B2, 0x00B5, 0x00B7, 0x00D7, 0x00F7,
+  0x0394, 0x03A3, 0x03A9, 0x03B1, 0x03B2, 0x03B8, 0x03BB, 0x03C0, 0x03C3,
+  0x03C9, 0x2022, 0x2126, 0x2190, 0x2191, 0x2192, 0x2193, 0x2588
+};
+
+/**
+ * @var const unsigned char dog_extended_set[]
+ * @brief Lookup-table containing 5x7 bitmap representations of the characters
+ *        listed in dog_extended_code_points[], in the same order.
+ */
+const unsigned char dog_extended_set[] =
+{
+	0x00, 0x06, 0x09, 0x09, 0x06,// U+00B0 degree sign
+	0x44, 0x44, 0x5F, 0x44, 0x44,// U+00B1 plus-minus sign
+	0x00, 0x19, 0x15, 0x12, 0x00,// U+00B2 superscript two
+	0x7C, 0x20, 0x20, 0x10, 0x3C,// U+00B5 micro sign
+	0x00, 0x00, 0x08, 0x00, 0x00,// U+00B7 middle dot
+	0x22, 0x14, 0x08, 0x14, 0x22,// U+00D7 multiplication sign
+	0x08, 0x08, 0x2A, 0x08, 0x08,// U+00F7 division sign
+	0x70, 0x4C, 0x43, 0x4C, 0x70,// U+0394 capital delta
+	0x63, 0x55, 0x49, 0x41, 0x41,// U+03A3 capital sigma
+	0x5E, 0x61, 0x01, 0x61, 0x5E,// U+03A9 capital omega
+	0x38, 0x44, 0x44, 0x38, 0x44,// U+03B1 small alpha
+	0x7E, 0x29, 0x29, 0x29, 0x16,// U+03B2 small beta
+	0x3E, 0x49, 0x49, 0x49, 0x3E,// U+03B8 small theta
+	0x43, 0x24, 0x18, 0x20, 0x40,// U+03BB small lambda
+	0x04, 0x7C, 0x04, 0x7C, 0x04,// U+03C0 small pi
+	0x38, 0x44, 0x44, 0x3C, 0x04,// U+03C3 small sigma
+	0x3C, 0x40, 0x30, 0x40, 0x3C,// U+03C9 small omega
+	0x00, 0x1C, 0x1C, 0x1C, 0x00,// U+2022 bullet
+	0x5E, 0x61, 0x01, 0x61, 0x5E,// U+2126 ohm sign
+	0x08, 0x1C, 0x2A, 0x08, 0x08,// U+2190 leftwards arrow
+	0x04, 0x02, 0x7F, 0x02, 0x04,// U+2191 upwards arrow
+	0x08, 0x08, 0x2A, 0x1C, 0x08,// U+2192 rightwards arrow
+	0x10, 0x20, 0x7F, 0x20, 0x10,// U+2193 downwards arrow
+	0x7F, 0x7F, 0x7F, 0x7F, 0x7F,// U+2588 full block
+};
+
+/** Number of characters in the extended character set */
+#define DOG_EXTENDED_COUNT \
+        (sizeof(dog_extended_code_points) / sizeof(dog_extended_code_points[0]))
+
+/** dog_utf8_feed(): the sequence is not complete yet */
+#define DOG_UTF8_MORE  0
+/** dog_utf8_feed(): a character is complete and the byte has been used */
+#define DOG_UTF8_DONE  1
+/** dog_utf8_feed(): a broken sequence has ended as a character; the byte has
+ *  not been used and must be fed again */
+#define DOG_UTF8_AGAIN 2
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** used to hold the state of a UTF-8 sequence being decoded */
+typedef struct
+{
+  uint16_t code_point;      /**< code point assembled so far              */
+  uint8_t length;           /**< bytes in the sequence                    */
+  uint8_t pending;          /**< continuation bytes still expected        */
+} dog_utf8_t;
+
 /*----------------------------------------------------------------------------*/
 /* STATIC VARIABLES                                                           */
 /*----------------------------------------------------------------------------*/
@@ -161,24 +232,307 @@ static uint8_t page = 0, col = 0; /* Used to store the current column and page
                                    * individual pixel rows, so page is a number
                                    * from 0-7.
                                    */
+
+/**
+ * @var static dog_utf8_t utf8
+ * @brief The UTF-8 sequence putchar() is in the middle of.
+ */
+static dog_utf8_t utf8 = {0, 0, 0};
                                
+#if DOG_GLYPH_CACHE_BYTES > 0
+/** used to hold one pre-shifted character of the glyph cache */
+typedef struct
+{
+  const unsigned char *glyph;            /* character bitmap, 0 when unused */
+  uint16_t stamp;                        /* time of last use, for LRU       */
+  uint8_t shift;                         /* row offset within the page      */
+  uint8_t top[DOG_GLYPH_WIDTH];          /* columns for the upper page      */
+  uint8_t bottom[DOG_GLYPH_WIDTH];       /* columns for the lower page      */
+} dog_glyph_cache_entry_t;
+
+/* The preprocessor cannot use sizeof, so the size of an entry is worked out
+ * from its members and rounded up to the alignment of the pointer. The
+ * estimate is never less than sizeof(dog_glyph_cache_entry_t), so the cache
+ * never takes more RAM than DOG_GLYPH_CACHE_BYTES. */
+#ifdef __SIZEOF_POINTER__
+#define DOG_GLYPH_POINTER_BYTES __SIZEOF_POINTER__
+#else
+#define DOG_GLYPH_POINTER_BYTES 8
+#endif
+
+/** Bytes of RAM taken by one entry of the glyph cache */
+#define DOG_GLYPH_CACHE_ENTRY_BYTES                                        \
+        ((DOG_GLYPH_POINTER_BYTES + 3 + 2*DOG_GLYPH_WIDTH +                \
+          DOG_GLYPH_POINTER_BYTES - 1) /                                   \
+         DOG_GLYPH_POINTER_BYTES * DOG_GLYPH_POINTER_BYTES)
+
+/** Number of characters that fit in the glyph cache's RAM budget */
+#define DOG_GLYPH_CACHE_ENTRIES                                            \
+        (DOG_GLYPH_CACHE_BYTES / DOG_GLYPH_CACHE_ENTRY_BYTES)
+
+#if DOG_GLYPH_CACHE_ENTRIES < 1
+#error "DOG_GLYPH_CACHE_BYTES is too small to hold one character"
+#endif
+#if DOG_GLYPH_CACHE_ENTRIES > 255
+#error "DOG_GLYPH_CACHE_BYTES holds more than 255 characters"
+#endif
+
+/**
+ * @var static dog_glyph_cache_entry_t glyph_cache[]
+ * @brief Cache of characters already shifted for a given row offset.
+ *
+ * @var static uint16_t glyph_cache_clock
+ * @brief Incremented on every cache lookup; used to find the least recently
+ *        used entry. It wraps, so an entry left unused for 65536 lookups or
+ *        more may look more recent than it is.
+ */
+static dog_glyph_cache_entry_t glyph_cache[DOG_GLYPH_CACHE_ENTRIES];
+static uint16_t glyph_cache_clock = 0;
+#endif /* DOG_GLYPH_CACHE_BYTES */
+
 /*----------------------------------------------------------------------------*/
-/* FUNCTIONS                                                                  */
-/*----------------------------------------------------------------------------*/                                                           
-int putchar(int c)
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+/** This function is used to locate the bitmap of a character in the lookup
+ *  tables. Characters that are not part of either character set are replaced
+ *  by a question mark so that the tables are never read out of bounds.
+ *
+ *  @par Parameters
+ *    - @a c = The code point of the character to be looked up.
+ *
+ *  @par Algorithm
+ *       Code points between @b DOG_FIRST_CHAR and @b DOG_LAST_CHAR index
+ *       dog_character_set[] directly. Any other code point is looked up with a
+ *       binary search of dog_extended_code_points[].
+ *
+ *  @returns A pointer to the @b DOG_GLYPH_WIDTH bytes making up the character.
+ */
+static const unsigned char *dog_glyph(uint16_t c)
 {
-  int table_start;    /* Used as a starting index to the lookup table */
-  int table_end;      /* Lookup table ending index to the lookup table */
+  uint8_t low, high, mid;
+
+  if(c >= DOG_FIRST_CHAR && c <= DOG_LAST_CHAR)     /* Dense ASCII table */
+    return &dog_character_set[DOG_GLYPH_WIDTH*(c - DOG_FIRST_CHAR)];
+
+  low = 0;
+  high = DOG_EXTENDED_COUNT;
+  while(low < high)                         /* Binary search of the index */
+  {
+    mid = (low + high) >> 1;
+    if(dog_extended_code_points[mid] < c)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  if(low < DOG_EXTENDED_COUNT && dog_extended_code_points[low] == c)
+    return &dog_extended_set[DOG_GLYPH_WIDTH*low];
+
+  return &dog_character_set[DOG_GLYPH_WIDTH*('?' - DOG_FIRST_CHAR)];
+}
+
+/** This function is used to feed one byte of UTF-8 to a decoder. Both
+ *  putchar(), which gets its bytes one at a time, and dog_utf8_decode() go
+ *  through it, so that they agree on every byte sequence.
+ *
+ *  @par Parameters
+ *    - @a utf8 = The state of the decoder.
+ *    - @a byte = The byte.
+ *
+ *  @par Algorithm
+ *       2- and 3-byte sequences are decoded into their code points and
+ *       4-byte sequences, which lie beyond 16 bits, into
+ *       @b DOG_REPLACEMENT_CHAR. A sequence cut short by a byte which is not
+ *       a continuation byte ends as @b DOG_REPLACEMENT_CHAR and decoding
+ *       starts over from that byte. Continuation bytes without a lead byte
+ *       and bytes which never appear in UTF-8 decode into
+ *       @b DOG_REPLACEMENT_CHAR as well.
+ *
+ *  @returns @b DOG_UTF8_MORE, @b DOG_UTF8_DONE or @b DOG_UTF8_AGAIN; in the
+ *           last two cases the character is in @a utf8->code_point.
+ */
+static uint8_t dog_utf8_feed(dog_utf8_t *utf8, uint8_t byte)
+{
+  if(utf8->pending)
+  {
+    if((byte & 0xC0) != 0x80)                     /* Sequence cut short */
+    {
+      utf8->pending = 0;
+      utf8->code_point = DOG_REPLACEMENT_CHAR;
+      return DOG_UTF8_AGAIN;
+    }
+    utf8->code_point = (utf8->code_point << 6) | (byte & 0x3F);
+    if(--utf8->pending) return DOG_UTF8_MORE;
+    if(utf8->length == 4)           /* Beyond what we can display */
+      utf8->code_point = DOG_REPLACEMENT_CHAR;
+    return DOG_UTF8_DONE;
+  }
+
+  if(byte < 0x80)                                           /* ASCII */
+    utf8->code_point = byte;
+  else if(byte >= 0xC2 && byte < 0xF5)                      /* Lead byte */
+  {
+    utf8->length = (byte >= 0xF0) ? 4 : (byte >= 0xE0) ? 3 : 2;
+    utf8->pending = utf8->length - 1;
+    utf8->code_point = byte & (0x7F >> utf8->length);
+    return DOG_UTF8_MORE;
+  }
+  else                  /* Lone continuation byte or not UTF-8 at all */
+    utf8->code_point = DOG_REPLACEMENT_CHAR;
+  return DOG_UTF8_DONE;
+}
+
+#if DOG_GLYPH_CACHE_BYTES > 0
+/** This function is used to find a character shifted by a given row offset
+ *  in the glyph cache, shifting and inserting it if it is not there yet.
+ *
+ *  @par Parameters
+ *    - @a glyph = The bitmap of the character, as returned by dog_glyph().
+ *    - @a shift = The row offset within the page [1,7].
+ *
+ *  @par Algorithm
+ *       Searches the cache for a matching entry while keeping track of the
+ *       least recently used one. On a miss, the least recently used entry is
+ *       replaced by the newly shifted character.
+ *
+ *  @returns The cache entry holding the shifted character.
+ */
+static dog_glyph_cache_entry_t *dog_glyph_cache_lookup(
+                                            const unsigned char *glyph,
+                                            uint8_t shift)
+{
+  dog_glyph_cache_entry_t *entry = glyph_cache;
+  dog_glyph_cache_entry_t *oldest = glyph_cache;
+  uint8_t i;
+
+  ++glyph_cache_clock;
+
+  for(i = 0; i < DOG_GLYPH_CACHE_ENTRIES; ++i, ++entry)
+  {
+    if(entry->glyph == glyph && entry->shift == shift)
+    {
+      entry->stamp = glyph_cache_clock;           /* Hit: mark as recent */
+      return entry;
+    }
+  }
+
+  /* Miss: shift the character once into the least recently used entry */
+  for(entry = glyph_cache, i = 0; i < DOG_GLYPH_CACHE_ENTRIES; ++i, ++entry)
+  {
+    if((uint16_t)(glyph_cache_clock - entry->stamp) >
+       (uint16_t)(glyph_cache_clock - oldest->stamp))
+      oldest = entry;
+  }
+  oldest->glyph = glyph;
+  oldest->shift = shift;
+  oldest->stamp = glyph_cache_clock;
+  for(i = 0; i < DOG_GLYPH_WIDTH; ++i)
+  {
+    oldest->top[i]    = (uint8_t)(glyph[i] << shift);
+    oldest->bottom[i] = (uint8_t)(glyph[i] >> (DOG_PAGE_HEIGHT - shift));
+  }
+  return oldest;
+}
+#endif /* DOG_GLYPH_CACHE_BYTES */
+
+/** This function is used to OR the columns of a character into the buffer at
+ *  an arbitrary row offset within a page.
+ *
+ *  @par Parameters
+ *    - @a page  = The page holding the top of the character [0,7].
+ *    - @a col   = The left-hand column of the character.
+ *    - @a shift = The row of the top of the character within @a page [0,7].
+ *    - @a glyph = The bitmap of the character, as returned by dog_glyph().
+ *    - @a n     = The number of columns to place (already clipped).
+ *
+ *  @par Algorithm
+ *       Page-aligned characters are copied into a single page. Otherwise
+ *       each column is split across @a page and the page below it; the lower
+ *       page is skipped when the character does not reach it or when it lies
+ *       below the bottom of the display.
+ */
+static void dog_place_glyph(uint8_t page,
+                            uint8_t col,
+                            uint8_t shift,
+                            const unsigned char *glyph,
+                            uint8_t n)
+{
+  uint8_t *top = &dog_buffer[page][col];
+  uint8_t *bottom;
+#if DOG_GLYPH_CACHE_BYTES > 0
+  dog_glyph_cache_entry_t *entry;
+  uint8_t i;
+#endif /* DOG_GLYPH_CACHE_BYTES */
+
+  DOG_MARK_DIRTY(page, col);
+  DOG_MARK_DIRTY(page, col + n - 1);
+  DOG_STAT_ADD(buffer_bytes, n);
+  if(shift + DOG_GLYPH_HEIGHT > DOG_PAGE_HEIGHT && page + 1 < DOG_PAGE_HEIGHT)
+  {
+    DOG_MARK_DIRTY(page + 1, col);
+    DOG_MARK_DIRTY(page + 1, col + n - 1);
+    DOG_STAT_ADD(buffer_bytes, n);
+  }
+
+#if DOG_GLYPH_CACHE_BYTES > 0
+
+  if(shift)                     /* Shifted characters come from the cache */
+  {
+    entry = dog_glyph_cache_lookup(glyph, shift);
+
+    for(i = 0; i < n; ++i) top[i] |= entry->top[i];
+
+    if(shift + DOG_GLYPH_HEIGHT > DOG_PAGE_HEIGHT && 
+       page + 1 < DOG_PAGE_HEIGHT)
+    {
+      bottom = &dog_buffer[page + 1][col];
+      for(i = 0; i < n; ++i) bottom[i] |= entry->bottom[i];
+    }
+    return;
+  }
+#endif /* DOG_GLYPH_CACHE_BYTES */
+
+  if(shift + DOG_GLYPH_HEIGHT <= DOG_PAGE_HEIGHT || 
+     page + 1 >= DOG_PAGE_HEIGHT)          /* Only one page is touched */
+  {
+    while(n--) *top++ |= (uint8_t)(*glyph++ << shift);
+  }
+  else                                     /* Character straddles two pages */
+  {
+    bottom = &dog_buffer[page + 1][col];
+    while(n--)
+    {
+      *top++    |= (uint8_t)(*glyph << shift);
+      *bottom++ |= (uint8_t)(*glyph++ >> (DOG_PAGE_HEIGHT - shift));
+    }
+  }
+}
+
+/** This function is used to draw a decoded character at the position of
+ *  putchar() and advance the position.
+ *
+ *  @par Parameters
+ *    - @a code_point = The code point of the character; a newline clears the
+ *                      rest of the line and moves to the next page.
+ */
+static void dog_put_code_point(uint16_t code_point)
+{
+  const unsigned char *glyph; /* Bitmap of the character */
   int i;
 
-  if(c == '\n')      /* Detect newline character */
+  if(code_point == '\n')      /* Detect newline character */
   {
+   if(col < DOG_WIDTH)
+   {
+     DOG_MARK_DIRTY(page, col);
+     DOG_MARK_DIRTY(page, DOG_WIDTH - 1);
+     DOG_STAT_ADD(buffer_bytes, DOG_WIDTH - col);
+   }
    while(col < DOG_WIDTH)
      dog_buffer[page][col++] = 0;  /* If newline character, clear rest of line */
 
    ++ page;                     /* Then increment the page */
    col = 0;                    /* Next reset the column (ie. carriage return)*/
-   return 0;                   /* Return; nothing to do */
+   return;                     /* Return; nothing to do */
   }
 
   /* Note that the following two condition checks not only check for bounds, but
@@ -196,16 +550,16 @@ int putchar(int c)
    page = 0;                  /* If so, move to top of display */
   }
 
-  table_start = 5*(c - ' ');   /* Determine where to begin table lookup. */
+  glyph = dog_glyph(code_point);     /* Look up the character's bitmap */
 
-  table_end = table_start + 5; /* End location of table lookup will be at
-                                * a 5-byte offset.
-                                */
+  DOG_MARK_DIRTY(page, col);
+  DOG_MARK_DIRTY(page, col + DOG_GLYPH_WIDTH - 1);
+  DOG_STAT_ADD(buffer_bytes, DOG_GLYPH_WIDTH);
 
-  /* Place each byte cooresponding to character 'c' in the buffer. */
-  for(i = table_start; i < table_end; ++i, ++col)
+  /* Place each byte cooresponding to the character in the buffer. */
+  for(i = 0; i < DOG_GLYPH_WIDTH; ++i, ++col)
   {
-    dog_buffer[page][col] |= dog_character_set[i];
+    dog_buffer[page][col] |= glyph[i];
   }
 
   ++col;                       /* Increment col once more for proper spacing */
@@ -214,8 +568,24 @@ int putchar(int c)
                                                    * 1 column wide space between
                                                    * letters.
                                                    */
+}
 
-  return c;
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/                                                           
+int putchar(int c)
+{
+  uint8_t result = dog_utf8_feed(&utf8, (unsigned char)c);
+
+  if(result == DOG_UTF8_AGAIN)   /* Show the broken sequence, then start over */
+  {
+    dog_put_code_point(utf8.code_point);
+    result = dog_utf8_feed(&utf8, (unsigned char)c);
+  }
+  if(result == DOG_UTF8_MORE) return c;   /* Wait for the rest of it */
+
+  dog_put_code_point(utf8.code_point);
+  return (c == '\n') ? 0 : c;
 } /* putchar */
 
 int8_t dog_set_column(uint8_t new_col)
@@ -244,44 +614,208 @@ int8_t dog_set_page(uint8_t new_page)
 
 int8_t dog_putchar_select(uint8_t new_row, uint8_t new_col, char c)
 {
-  uint8_t old_col, old_page;
-  uint8_t top_page_height, bottom_page_height;
-  uint16_t table_start, table_end, i;
+  uint8_t n;
 
   /* Ensure that provided pixels are within range */
-  if((new_row + 7) >= DOG_HEIGHT) return -1;
-  if((new_col + 5) >= DOG_CHAR_WIDTH) return -1;
+  if(new_row >= DOG_HEIGHT) return -1;
+  if(new_col >= DOG_WIDTH) return -1;
 
-  old_col = col;
-  old_page = page;
+  /* Clip the character at the right-hand edge of the display */
+  n = (new_col + DOG_GLYPH_WIDTH > DOG_WIDTH) ? DOG_WIDTH - new_col 
+                                               : DOG_GLYPH_WIDTH;
 
-  col = new_col;
-  page = new_row>>3;
-  bottom_page_height = new_row % DOG_PAGE_HEIGHT;
-  top_page_height = 8-bottom_page_height;
-  
-  /* locate character in lookup table */
-  table_start = 5*(c - ' ');
-  table_end = table_start + 5;
+  dog_place_glyph(new_row >> 3, new_col, new_row % DOG_PAGE_HEIGHT,
+                  dog_glyph((unsigned char)c), n);
+  return c;
+}
+
+int8_t dog_draw_string_row(uint8_t row,
+                           uint8_t col,
+                           const char *str,
+                           dog_span_t *span)
+{
+  uint8_t page, shift, n;
+  uint8_t start = col;
+  int8_t count = 0;
+
+  /* Validate the position and work out the page split once */
+  if(row >= DOG_HEIGHT) return -1;
+  if(col >= DOG_WIDTH) return -1;
+
+  page = row >> 3;
+  shift = row % DOG_PAGE_HEIGHT;
+
+  /* Place characters until the string ends or the display edge is reached */
+  while(*str && col < DOG_WIDTH)
+  {
+    n = (col + DOG_GLYPH_WIDTH > DOG_WIDTH) ? DOG_WIDTH - col 
+                                             : DOG_GLYPH_WIDTH;
+    dog_place_glyph(page, col, shift, dog_glyph(dog_utf8_decode(&str)), n);
+    ++count;
+    if(col >= DOG_WIDTH - DOG_GLYPH_ADVANCE) break;
+    col += DOG_GLYPH_ADVANCE;
+  }
+
+  if(count && span)
+  {
+    span->page_start = page;
+    span->page_end   = page;
+    if(shift + DOG_GLYPH_HEIGHT > DOG_PAGE_HEIGHT && page+1 < DOG_PAGE_HEIGHT)
+      span->page_end = page + 1;
+    span->col_start  = start;
+    span->col_end    = (col + DOG_GLYPH_WIDTH > DOG_WIDTH) ? 
+                       DOG_WIDTH - 1 : col + DOG_GLYPH_WIDTH - 1;
+  }
+  return count;
+}
+
+#if DOG_GLYPH_CACHE_BYTES > 0
+void dog_glyph_cache_flush(void)
+{
+  uint8_t i;
+
+  for(i = 0; i < DOG_GLYPH_CACHE_ENTRIES; ++i)
+    glyph_cache[i].glyph = 0;
+}
+#endif /* DOG_GLYPH_CACHE_BYTES */
+
+int8_t dog_draw_glyph(uint8_t page, uint8_t col, uint16_t c)
+{
+  const unsigned char *glyph;
+  uint8_t *dst;
+  uint8_t n;
+
+  if(page >= DOG_CHAR_HEIGHT) return -1;
+  if(col >= DOG_WIDTH) return -1;
+
+  glyph = dog_glyph(c);
+  dst = &dog_buffer[page][col];
+
+  DOG_MARK_DIRTY(page, col);
+  DOG_MARK_DIRTY(page, (col + DOG_GLYPH_WIDTH <= DOG_WIDTH) ? 
+                       col + DOG_GLYPH_WIDTH - 1 : DOG_WIDTH - 1);
+  DOG_STAT_ADD(buffer_bytes, (col + DOG_GLYPH_WIDTH <= DOG_WIDTH) ?
+                             DOG_GLYPH_WIDTH : DOG_WIDTH - col);
+
+  if(col + DOG_GLYPH_WIDTH <= DOG_WIDTH)     /* Common case: no clipping */
+  {
+    dst[0] = glyph[0];
+    dst[1] = glyph[1];
+    dst[2] = glyph[2];
+    dst[3] = glyph[3];
+    dst[4] = glyph[4];
+  }
+  else                                  /* Clip at the right-hand edge */
+  {
+    for(n = DOG_WIDTH - col; n; --n) *dst++ = *glyph++;
+  }
+  return 0;
+}
+
+uint16_t dog_utf8_decode(const char **str)
+{
+  const unsigned char *s = (const unsigned char *)*str;
+  dog_utf8_t utf8 = {0, 0, 0};
+  uint8_t result;
+
+  /* A byte which cuts a sequence short, the terminating null character
+   * included, is left for the next call */
+  do
+  {
+    result = dog_utf8_feed(&utf8, *s);
+    if(result != DOG_UTF8_AGAIN) ++s;
+  } while(result == DOG_UTF8_MORE);
+
+  *str = (const char *)s;
+  return utf8.code_point;
+}
+
+uint16_t dog_measure_string(const char *str)
+{
+  uint16_t count = 0;
+
+  while(*str)                                   /* Count the characters */
+  {
+    dog_utf8_decode(&str);
+    ++count;
+  }
+
+  if(count == 0) return 0;
+  return count*DOG_GLYPH_ADVANCE - 1;   /* No space after the last character */
+}
+
+int8_t dog_draw_string(uint8_t page,
+                       uint8_t col,
+                       uint8_t width,
+                       dog_align_t align,
+                       const char *str,
+                       dog_span_t *span)
+{
+  uint16_t text_width;
+  uint8_t count, drawn, lead, trail;
+  uint8_t *dst;
+  const unsigned char *glyph;
+
+  /* Validate the field once rather than once per character */
+  if(page >= DOG_CHAR_HEIGHT) return -1;
+  if(col >= DOG_WIDTH) return -1;
+
+  text_width = dog_measure_string(str);
+
+  if(width == 0)                    /* Field is exactly as wide as the text */
+  {
+    width = (text_width > DOG_WIDTH) ? DOG_WIDTH : (uint8_t)text_width;
+    align = DOG_ALIGN_LEFT;
+  }
+  if(width > DOG_WIDTH - col) width = DOG_WIDTH - col; /* Clip to the display */
+  if(width == 0) return 0;
+
+  /* Truncate the string to the number of whole characters that fit */
+  drawn = (width + 1) / DOG_GLYPH_ADVANCE;
+  if((text_width + 1) / DOG_GLYPH_ADVANCE < drawn)
+    drawn = (uint8_t)((text_width + 1) / DOG_GLYPH_ADVANCE);
+  text_width = drawn ? drawn*DOG_GLYPH_ADVANCE - 1 : 0;
+
+  /* Place the text within the field */
+  switch(align)
+  {
+  case DOG_ALIGN_CENTER: lead = (width - text_width) >> 1; break;
+  case DOG_ALIGN_RIGHT:  lead = width - text_width;        break;
+  default:               lead = 0;                         break;
+  }
+  trail = width - text_width - lead;
+
+  /* Walk along the page once: leading space, glyphs, trailing space */
+  dst = &dog_buffer[page][col];
+  while(lead--) *dst++ = 0;
   
-  /* Place character in buffer */
-  for(i = table_start; i < table_end; ++i, ++col)
+  count = drawn;
+  while(count--)
   {
-    dog_buffer[page][col] |= dog_character_set[i]<<bottom_page_height;
-    dog_buffer[page+1][col] |= dog_character_set[i]>>top_page_height;
+    glyph = dog_glyph(dog_utf8_decode(&str));
+    *dst++ = glyph[0];
+    *dst++ = glyph[1];
+    *dst++ = glyph[2];
+    *dst++ = glyph[3];
+    *dst++ = glyph[4];
+    if(count) *dst++ = 0;           /* Space between neighbouring characters */
   }
+  
+  while(trail--) *dst++ = 0;
 
-  ++col;                       /* Increment col once more for proper spacing */
+  DOG_MARK_DIRTY(page, col);
+  DOG_MARK_DIRTY(page, col + width - 1);
+  DOG_STAT_ADD(buffer_bytes, width);
 
-  if(col < DOG_CHAR_WIDTH)
+  if(span)
   {
-    dog_buffer[page][col] |= 0;         /* If not end of line, add     */
-    dog_buffer[++page][col] |= 0;       /* 1 column wide space between */
-  }                                    /* letters.                    */
+    span->page_start = page;
+    span->page_end   = page;
+    span->col_start  = col;
+    span->col_end    = col + width - 1;
+  }
 
-  page = old_page;
-  col = old_col;
-  return c;
+  return (int8_t)drawn;
 }
 
 /* @} */ /* DOGM128_characters_source */
\ No newline at end of file
@@ -9,7 +9,9 @@
  * This file contains function prototypes to write characters to the DOGM128. 
  * It contains a 5x7 ASCII character set and functions so that the user only   
  * needs to pass @b chars when placing a character on the screen rather than  
- * manually setting each individual pixel. Note that the functions included in 
+ * manually setting each individual pixel. A sparse extended character set
+ * (degree sign, micro sign, some Greek letters, arrows, ...) is reachable
+ * through UTF-8 strings. Note that the functions included in 
  * this file DO NOT assume that the user has initialized the display.
  *
  *
@@ -47,6 +49,37 @@
 /** Surprise character, just for fun! */
 #define DOG_HIDDEN_MICKEY 128 
 
+/** Width of a single glyph in pixels */
+#define DOG_GLYPH_WIDTH 5
+
+/** Height of a single glyph in pixels */
+#define DOG_GLYPH_HEIGHT 7
+
+/** Horizontal distance between the left-hand side of two neighbouring glyphs
+  * (the glyph itself plus the 1-column wide space).
+  */
+#define DOG_GLYPH_ADVANCE 6
+
+/** Code point returned by dog_utf8_decode() for characters that cannot
+  * be represented in 16 bits and for bytes which are not valid UTF-8.
+  */
+#define DOG_REPLACEMENT_CHAR 0xFFFD
+
+/** First character contained in the character set */
+#define DOG_FIRST_CHAR ' '
+
+/** Last character contained in the dense character set. Other characters 
+  * are looked up in the extended character set.
+  */
+#define DOG_LAST_CHAR DOG_HIDDEN_MICKEY
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** used for the alignment of a string within its field */
+typedef enum{DOG_ALIGN_LEFT = 0, DOG_ALIGN_CENTER, DOG_ALIGN_RIGHT} dog_align_t;
+
 /*----------------------------------------------------------------------------*/
 /* FUNCTION HEADERS                                                           */
 /*----------------------------------------------------------------------------*/
@@ -68,7 +101,9 @@
  *       has not been reached (if it has, it will wrap around to the top of
  *       the display). Finally, it looks up the character's bitmap in a
  *       lookup table and prints that to the display buffer contained in
- *       the common.c file.
+ *       the common.c file. Bytes are decoded as UTF-8 by the same rules as
+ *       dog_utf8_decode(); nothing is drawn until the last byte of a
+ *       sequence arrives.
  *
  *  @par Assumptions
  *       - The user has no data they wish to leave on the screen that is
@@ -125,16 +160,15 @@ int8_t dog_set_column(uint8_t new_col);
 /** This function is used to write a character to the screen at any row
  *  (not page) or column on the screen regardless of the current cursor
  *  position. In other words, the character being written to the screen is not
- *  restricted to a particular page or column. @b NOTE: This function does not1
- *  move the current position; it will assume its old position before the
- *  function returns.
+ *  restricted to a particular page or column. @b NOTE: This function does not
+ *  move the current position.
  *
  *  @par Parameters
  *         - @a row =  The desired row to place the character relative to
- *                  the top of character.
+ *                  the top of character [0,63].
  *
  *         - @a new_col = The desired column to place the character to the left
- *                      hand side of the character.
+ *                      hand side of the character [0,127].
  * 
  *         - @a c = The character to be written to the screen.
  *
@@ -142,16 +176,167 @@ int8_t dog_set_column(uint8_t new_col);
  *       Ensures that the provided row and column are within range. It then
  *       determines the page or pages in which the character will be placed on
  *       and the portion of the character that will be placed on each page.
- *       Next it looks up the character's bitmap in the character lookup table
- *       and places it in the screen buffer.
+ *       The second page is only touched when the character actually crosses
+ *       the page boundary. Next it looks up the character's bitmap in the 
+ *       character lookup table and ORs it into the screen buffer, clipping
+ *       whatever falls off the right-hand or bottom edge of the display.
  *
  *  @par Assumptions
  *       - None
  *
+ *  @returns Upon successful completion, the function returns the character
+ *           @a c. Otherwise it returns -1.
+ */
+int8_t dog_putchar_select(uint8_t row, uint8_t new_col, char c);
+
+/** This function is used to write a whole string at any row (not page) and
+ *  column of the screen. It is the string equivalent of dog_putchar_select()
+ *  and does not move the current position either.
+ *
+ *  @par Parameters
+ *         - @a row  = The row of the top of the characters [0,63].
+ *         - @a col  = The left-hand column of the first character [0,127].
+ *         - @a str  = The null-terminated string to be written.
+ *         - @a span = Optional (may be NULL). Receives the region of the
+ *                     buffer that was written.
+ *
+ *  @par Algorithm
+ *       Validates the position and works out the page split once for the
+ *       whole string, then ORs the characters into the buffer one after
+ *       another. Characters are clipped at the right-hand and bottom edges of
+ *       the display; drawing stops at the first character that would start
+ *       off the right-hand edge.
+ *
+ *  @par Assumptions
+ *       - None
+ *
+ *  @returns The number of characters written upon successful completion, or
+ *           -1 if @a row or @a col is out of range. @a span is only written
+ *           when at least one character was written.
+ */
+int8_t dog_draw_string_row(uint8_t row,
+                           uint8_t col,
+                           const char *str,
+                           dog_span_t *span);
+
+/** This function is used to draw a single character at any page and column
+ *  of the buffer without moving the putchar() cursor. It is the building block
+ *  used by the string and numeric functions and may be used standalone to
+ *  update a single character cell.
+ *
+ *  @par Parameters
+ *         - @a page = The page on which to draw the character [0,7].
+ *         - @a col  = The left-hand column of the character [0,127].
+ *         - @a c    = The code point of the character to be drawn.
+ *
+ *  @par Algorithm
+ *       Looks up the character's bitmap and copies its columns into the
+ *       buffer, dropping any columns which would fall off the right-hand edge
+ *       of the display.
+ *
+ *  @par Assumptions
+ *       - The @b DOG_GLYPH_WIDTH columns of the character replace the
+ *         contents of the buffer; the space following the character is left
+ *         untouched.
+ *
  *  @returns Upon successful completion, the function returns zero. Otherwise it
  *           returns -1.
  */
-int8_t dog_putchar_select(uint8_t row, uint8_t new_col, char c);
+int8_t dog_draw_glyph(uint8_t page, uint8_t col, uint16_t c);
+
+/** This function is used to decode a single character of a UTF-8 string.
+ *  All string functions in this file accept UTF-8, and putchar() decodes
+ *  UTF-8 sequences arriving one byte at a time.
+ *
+ *  @par Parameters
+ *         - @a str = Pointer to the string pointer. It is advanced past the
+ *                    decoded character.
+ *
+ *  @par Algorithm
+ *       Decodes well-formed 2- and 3-byte sequences into their code points.
+ *       4-byte sequences are decoded into @b DOG_REPLACEMENT_CHAR, and so are
+ *       sequences cut short, continuation bytes without a lead byte and bytes
+ *       which never appear in UTF-8; a sequence cut short by a new lead byte
+ *       ends before it, so that the next call starts from that byte. The
+ *       @b DOG_HIDDEN_MICKEY character is U+0080, "\xC2\x80" in UTF-8.
+ *
+ *  @par Assumptions
+ *       - @a *str does not point at the terminating null character.
+ *
+ *  @returns The code point of the decoded character.
+ */
+uint16_t dog_utf8_decode(const char **str);
+
+/** This function is used to compute the width of a string in pixels without
+ *  drawing it. The width includes the 1-column wide space between characters
+ *  but not the one following the last character.
+ *
+ *  @par Parameters
+ *         - @a str = The null-terminated string to be measured.
+ *
+ *  @par Algorithm
+ *       Counts the (UTF-8) characters in @a str and multiplies the count by
+ *       @b DOG_GLYPH_ADVANCE, removing the trailing space.
+ *
+ *  @par Assumptions
+ *       - None
+ *
+ *  @returns The width of the string in pixels (0 for an empty string).
+ */
+uint16_t dog_measure_string(const char *str);
+
+/** This function is used to draw a whole string into a fixed-width field on a
+ *  single page of the buffer. Unlike putchar(), the field is validated once
+ *  and the glyphs are copied with a single walk along the page, so it is the
+ *  preferred way of updating fixed-position labels and readouts.
+ *
+ *  @par Parameters
+ *         - @a page  = The page on which to draw the string [0,7].
+ *         - @a col   = The left-hand column of the field [0,127].
+ *         - @a width = The width of the field in pixels. Columns of the field
+ *                      not covered by the string are cleared. If set to zero,
+ *                      the field is exactly as wide as the string and
+ *                      @a align is ignored.
+ *         - @a align = @b DOG_ALIGN_LEFT, @b DOG_ALIGN_CENTER or
+ *                      @b DOG_ALIGN_RIGHT; placement of the string within
+ *                      the field.
+ *         - @a str   = The null-terminated string to be drawn.
+ *         - @a span  = Optional (may be NULL). Receives the region of the
+ *                      buffer that was written.
+ *
+ *  @par Algorithm
+ *       Clips the field to the right-hand edge of the display, then measures
+ *       the string and truncates it to the number of whole characters that
+ *       fit in the field. The leading space, glyphs and trailing space are
+ *       then written in one pass from left to right.
+ *
+ *  @par Assumptions
+ *       - The contents of the field are replaced rather than OR-ed with the
+ *         characters, so anything previously drawn in the field is erased.
+ *
+ *  @returns The number of characters drawn upon successful completion, or -1
+ *           if @a page or @a col is out of range. @a span is only written
+ *           when at least one column of the buffer was written.
+ */
+int8_t dog_draw_string(uint8_t page,
+                       uint8_t col,
+                       uint8_t width,
+                       dog_align_t align,
+                       const char *str,
+                       dog_span_t *span);
+
+#if DOG_GLYPH_CACHE_BYTES > 0
+/** This function is used to empty the cache of pre-shifted characters. It
+ *  only needs to be called if the character set is modified at run time.
+ *
+ *  @par Algorithm
+ *       Marks every entry of the cache as unused.
+ *
+ *  @par Assumptions
+ *       - None
+ */
+void dog_glyph_cache_flush(void);
+#endif /* DOG_GLYPH_CACHE_BYTES */
 
 #endif /* DOGM128_CHARACTERS_H */
 
@@ -0,0 +1,123 @@
+/*
+ * @file   DOGM128_chart.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for strip charts on the EA DOGM128. <br>
+ * @defgroup DOGM128_chart_source
+ * @{
+ *
+ * This file contains the source code for the functions described in
+ * chart.h. The user should include this file, along with rectangle.c and
+ * scroll.c, in his or her project should they choose to use strip charts.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_chart.h"
+#include "DOGM128_rectangle.h"
+#include "DOGM128_scroll.h"
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to find the row on which a sample is plotted.
+ *
+ *  @par Parameters
+ *    - @a chart  = The chart.
+ *    - @a sample = The sample.
+ *
+ *  @returns The row of the sample, clipped to the chart.
+ */
+static uint8_t dog_chart_row(const dog_chart_t *chart, int16_t sample)
+{
+  if(sample <= chart->min) return chart->y + chart->height - 1;
+  if(sample >= chart->max) return chart->y;
+
+  return chart->y + chart->height - 1 -
+         (uint8_t)(((int32_t)sample - chart->min) * (chart->height - 1) /
+                   ((int32_t)chart->max - chart->min));
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int8_t dog_chart_init(dog_chart_t *chart,
+                      uint8_t x,
+                      uint8_t y,
+                      uint8_t width,
+                      uint8_t height,
+                      int16_t min,
+                      int16_t max,
+                      uint8_t decimation)
+{
+  /* Ensure the whole chart fits on the display */
+  if(x >= DOG_WIDTH || y >= DOG_HEIGHT) return -1;
+  if(width < 2 || width > DOG_WIDTH - x) return -1;
+  if(height == 0 || height > DOG_HEIGHT - y) return -1;
+  if(max <= min || decimation == 0) return -1;
+
+  chart->x = x;
+  chart->y = y;
+  chart->width = width;
+  chart->height = height;
+  chart->min = min;
+  chart->max = max;
+  chart->decimation = decimation;
+  chart->count = 0;
+  chart->last_row = DOG_CHART_NONE;
+  return 0;
+}
+
+int8_t dog_chart_push(dog_chart_t *chart, int16_t sample, dog_span_t *span)
+{
+  uint8_t col, top, bottom;
+
+  /* Collect the range of the samples for the next column */
+  if(chart->count == 0 || sample < chart->low)  chart->low = sample;
+  if(chart->count == 0 || sample > chart->high) chart->high = sample;
+  if(chart->count < chart->decimation) ++chart->count;
+  if(chart->count < chart->decimation) return 0;
+
+  /* Should the scroll be refused, the count stays at the decimation, so the
+   * samples, this one included, are kept and the next call tries again */
+  col = chart->x + chart->width - 1;
+  if(dog_scroll_h(chart->x, chart->y, col, chart->y + chart->height - 1, -1,
+                  'c') < 0)
+    return -1;
+  chart->count = 0;
+
+  /* Rows grow downwards, so the highest sample has the smallest row */
+  top = dog_chart_row(chart, chart->high);
+  bottom = dog_chart_row(chart, chart->low);
+  if(chart->last_row != DOG_CHART_NONE)
+  {
+    if(chart->last_row < top)    top = chart->last_row;
+    if(chart->last_row > bottom) bottom = chart->last_row;
+  }
+  chart->last_row = dog_chart_row(chart, sample);
+
+  dog_fill_rectangle(col, top, col, bottom, 's');
+
+  if(span)
+  {
+    span->page_start = chart->y >> 3;
+    span->page_end = (chart->y + chart->height - 1) >> 3;
+    span->col_start = chart->x;
+    span->col_end = col;
+  }
+  return 1;
+}
+
+void dog_chart_clear(dog_chart_t *chart)
+{
+  dog_fill_rectangle(chart->x, chart->y, chart->x + chart->width - 1,
+                     chart->y + chart->height - 1, 'c');
+  chart->count = 0;
+  chart->last_row = DOG_CHART_NONE;
+}
+
+/* @} */ /* DOGM128_chart_source */
@@ -0,0 +1,123 @@
+/**
+ * @file   DOGM128_chart.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Header file for strip charts on the EA DOGM128. <br>
+ * @defgroup DOGM128_chart Strip Charts
+ * @{
+ *
+ * This file contains function prototypes for strip charts, which plot a
+ * rolling trend in a rectangular region of the buffer. When a new column is
+ * due, the region is shifted one column to the left, a page at a time with
+ * memmove(), and only the newest column is drawn; the points already on the
+ * chart are never plotted again (see dog_scroll_h()).
+ *
+ * When samples arrive faster than columns should scroll, several samples
+ * are combined into one column, which then shows their minimum and maximum,
+ * so that short peaks remain visible.
+ *
+ * Note that every scroll changes every column of the region, so a flush
+ * after each scroll sends the whole region.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_CHART_H
+#define DOGM128_CHART_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Value of the @a last_row member before the first column is drawn */
+#define DOG_CHART_NONE  0xFF
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** used to store the state of a strip chart between samples */
+typedef struct
+{
+  uint8_t x;                /**< left-hand column of the chart             */
+  uint8_t y;                /**< top row of the chart                      */
+  uint8_t width;            /**< width of the chart in columns             */
+  uint8_t height;           /**< height of the chart in rows               */
+  int16_t min;              /**< sample value plotted on the bottom row    */
+  int16_t max;              /**< sample value plotted on the top row       */
+  uint8_t decimation;       /**< samples combined into one column          */
+  uint8_t count;            /**< samples collected for the next column     */
+  int16_t low;              /**< smallest of the samples collected         */
+  int16_t high;             /**< largest of the samples collected          */
+  uint8_t last_row;         /**< row of the last sample plotted            */
+} dog_chart_t;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to set up a strip chart. Nothing is drawn; the
+ *  region is assumed to be clear (see dog_chart_clear()).
+ *
+ *  @par Parameters
+ *         - @a chart      = The chart to be set up.
+ *         - @a x          = Left-hand column of the chart [0,127].
+ *         - @a y          = Top row of the chart [0,63].
+ *         - @a width      = Width of the chart in columns [2,128].
+ *         - @a height     = Height of the chart in rows [1,64].
+ *         - @a min        = Sample value plotted on the bottom row.
+ *         - @a max        = Sample value plotted on the top row; greater
+ *                           than @a min.
+ *         - @a decimation = Samples combined into one column [1,255].
+ *
+ *  @returns Upon successful completion, the function returns zero. It returns
+ *           -1 if the chart does not fit on the display or a parameter is out
+ *           of range.
+ */
+int8_t dog_chart_init(dog_chart_t *chart,
+                      uint8_t x,
+                      uint8_t y,
+                      uint8_t width,
+                      uint8_t height,
+                      int16_t min,
+                      int16_t max,
+                      uint8_t decimation);
+
+/** This function is used to add a sample to a strip chart.
+ *
+ *  @par Parameters
+ *         - @a chart  = The chart.
+ *         - @a sample = The sample; values outside [min,max] are clipped.
+ *         - @a span   = Optional (may be NULL). Receives the region of the
+ *                       buffer that was rewritten.
+ *
+ *  @par Algorithm
+ *       The sample is folded into the minimum and maximum of the samples
+ *       collected for the next column. Once @a decimation samples have been
+ *       collected, the chart is scrolled one column to the left with
+ *       dog_scroll_h(), which clears the rightmost column. A vertical stroke
+ *       is then drawn there from the previous sample to the range of the
+ *       collected ones, which keeps the trace connected.
+ *
+ *  @par Assumptions
+ *       - Nothing else draws inside the region.
+ *       - The orientation is one of the landscape modes.
+ *
+ *  @returns 1 if the chart scrolled, 0 if the sample was only collected,
+ *           and -1 if the chart could not be scrolled (e.g. in a portrait
+ *           orientation); the samples collected are then kept and nothing is
+ *           drawn. @a span is only written when the chart scrolled.
+ */
+int8_t dog_chart_push(dog_chart_t *chart, int16_t sample, dog_span_t *span);
+
+/** This function is used to clear the region of a strip chart and restart
+ *  the trace.
+ */
+void dog_chart_clear(dog_chart_t *chart);
+
+#endif /* DOGM128_CHART_H */
+/** @} */ /* DOGM128_chart */
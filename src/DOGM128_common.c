@@ -27,11 +27,87 @@
 /* GLOBAL DATA                                                                */
 /*----------------------------------------------------------------------------*/
 /**
- * @var uint8_t dog_buffer[DOG_PAGE_HEIGHT][DOG_WIDTH]
+ * @var uint8_t dog_main_buffer[DOG_PAGE_HEIGHT][DOG_WIDTH]
  * @brief External buffer used for storing screen contents before sending data
  *        to screen.
+ *
+ * @var dog_dirty_t dog_main_dirty
+ * @brief Part of dog_main_buffer changed since it was last sent to the screen.
+ *
+ * @var uint8_t (*dog_buffer)[DOG_WIDTH]
+ * @brief Draw target; points at dog_main_buffer unless redirected.
+ *
+ * @var dog_dirty_t *dog_dirty
+ * @brief Dirty region belonging to the draw target.
+ */
+uint8_t dog_main_buffer[DOG_PAGE_HEIGHT][DOG_WIDTH];
+dog_dirty_t dog_main_dirty = DOG_DIRTY_CLEAN;
+uint8_t (*dog_buffer)[DOG_WIDTH] = dog_main_buffer;
+dog_dirty_t *dog_dirty = &dog_main_dirty;
+
+/**
+ * @var const dog_spi_config_t dog_spi_default_config
+ * @brief SPI settings taken from DOGM128_user_config.h.
+ *
+ * @var uint8_t dog_spi_bitbang
+ * @brief Set while bytes are shifted out in software.
+ */
+const dog_spi_config_t dog_spi_default_config = 
+{
+  DOG_SPI_DIVIDER, DOG_MSB_FIRST, 0
+};
+uint8_t dog_spi_bitbang = 0;
+
+/**
+ * @var dog_orientation_t dog_orientation
+ * @brief Orientation selected with dog_set_orientation().
+ *
+ * @var uint8_t dog_width
+ * @brief Width of the drawing area for the current orientation.
+ *
+ * @var uint8_t dog_height
+ * @brief Height of the drawing area for the current orientation.
+ *
+ * @var uint8_t dog_column_offset
+ * @brief Column address of the leftmost visible column.
+ */
+dog_orientation_t dog_orientation = DOG_ORIENT_0;
+uint8_t dog_width = DOG_WIDTH;
+uint8_t dog_height = DOG_HEIGHT;
+uint8_t dog_column_offset = 0;
+
+#if DOG_STATS
+/**
+ * @var dog_stats_t dog_stats
+ * @brief Counters of the work done by the library.
+ *
+ * @var uint32_t dog_stats_flush_start
+ * @brief Tick count at the start of the flush being timed.
+ */
+dog_stats_t dog_stats;
+uint32_t dog_stats_flush_start;
+#endif /* DOG_STATS */
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static dog_bit_order_t bitbang_order
+ * @brief Bit order used when bit-banging.
+ */
+#if DOG_TRANSPORT != DOG_TRANSPORT_LINUX
+static dog_bit_order_t bitbang_order = DOG_MSB_FIRST;
+#endif
+
+/**
+ * @var static const uint8_t orientation_adc[]
+ * @brief ADC select command for each orientation.
+ *
+ * @var static const uint8_t orientation_com[]
+ * @brief Common output mode command for each orientation.
  */
-uint8_t dog_buffer[DOG_PAGE_HEIGHT][DOG_WIDTH];
+static const uint8_t orientation_adc[] = {0xA1, 0xA0, 0xA0, 0xA1, 0xA1, 0xA0};
+static const uint8_t orientation_com[] = {0xC0, 0xC8, 0xC0, 0xC8, 0xC8, 0xC0};
 
 /*----------------------------------------------------------------------------*/
 /* FUNCTIONS                                                                  */
@@ -48,54 +124,43 @@ void dog_init(dog_display_mode_t display_mode, uint8_t contrast)
   display_mode &= 1;            /* mask out all but LSB */
   contrast &= 63;               /* mask out 2 MSB's */
   
-  DOG_SPDR = 0x40; /* start at line 0 */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+  DOG_SPI_TRANSMIT(0x40); /* start at line 0 */
 
-  DOG_SPDR = 0xA1; /* ADC reverse (for 6:00 viewing) */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+  /* ADC reverse and normal common output for 6:00 viewing, unless another
+   * orientation was selected
+   */
+  DOG_SPI_TRANSMIT(orientation_adc[dog_orientation]);
 
-  DOG_SPDR = 0xC0; /* Normal common output */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+  DOG_SPI_TRANSMIT(orientation_com[dog_orientation]);
 
-  DOG_SPDR = (0xA6 | display_mode); /* display_mode = 0 => DOG_NORMAL_DISPLAY. 
+  DOG_SPI_TRANSMIT((0xA6 | display_mode)); /* display_mode = 0 => DOG_NORMAL_DISPLAY. 
                                  * display_mode = 1 => inverted display. 
                                  */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
 
-  DOG_SPDR = 0xA2; /* LCD drive voltage bias set 1/9 */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+  DOG_SPI_TRANSMIT(0xA2); /* LCD drive voltage bias set 1/9 */
 
-  DOG_SPDR = 0x2F; /* Power control: booster, regulator, and follower on
+  DOG_SPI_TRANSMIT(0x2F); /* Power control: booster, regulator, and follower on
                   (for 3.3V operation).
                   */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
 
   /* Booster adjustment must be done in 2 SPI writes */
-  DOG_SPDR = 0xF8; /* Booster Set Ratio 4x */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+  DOG_SPI_TRANSMIT(0xF8); /* Booster Set Ratio 4x */
 
-  DOG_SPDR = 0x00; /* Booster Set Ratio 4x */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+  DOG_SPI_TRANSMIT(0x00); /* Booster Set Ratio 4x */
 
-  DOG_SPDR = 0x27; /* Voltage Regulator Set */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+  DOG_SPI_TRANSMIT(0x27); /* Voltage Regulator Set */
 
   /* Contrast adjustment must be done in 2 SPI writes */
-  DOG_SPDR = 0x81; /* Send Command to adjust contrast */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+  DOG_SPI_TRANSMIT(0x81); /* Send Command to adjust contrast */
 
-  DOG_SPDR = contrast; /* Adjust contrast */  //originally 0x16
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+  DOG_SPI_TRANSMIT(contrast); /* Adjust contrast */  //originally 0x16
 
   /* Static indicator set must be done in 2 SPI writes */
-  DOG_SPDR = 0xAC; /* static indicator set */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+  DOG_SPI_TRANSMIT(0xAC); /* static indicator set */
 
-  DOG_SPDR = 0x00; /* static indicator set */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+  DOG_SPI_TRANSMIT(0x00); /* static indicator set */
 
-  DOG_SPDR = 0xAF; /* Finally, turn the display on */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+  DOG_SPI_TRANSMIT(0xAF); /* Finally, turn the display on */
  
   dog_clear_display(); /* clear any random data on the screen */
   DOG_SLAVE_DESELECT();    /* Deselect the slave */
@@ -114,42 +179,43 @@ void dog_clear_display(void)
   for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
   {
     DOG_SEND_COMMAND();   /* Ready display to receive commands */
-    DOG_SPDR = 0xB0 | page;   /* Send over page number to write to */
-    while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+    DOG_SPI_TRANSMIT(0xB0 | page);   /* Send over page number to write to */
+    DOG_SPI_TRANSMIT(0x10);        /* Send upper column address, 0*/
+    DOG_SPI_TRANSMIT(0x00);        /* Send lower column address, 0*/
     
-    /* Loop across all columns until the page (line) is filled */
-    for(col = 0; col < DOG_WIDTH; ++col)
+    /* Loop across all columns until the page (line) is filled. The whole
+     * RAM is cleared, including the columns which only become visible in
+     * another orientation.
+     */
+    DOG_SEND_DATA();      /* Ready the display to receive data */
+    for(col = 0; col < DOG_RAM_WIDTH; ++col)
     {
-      DOG_SEND_DATA();    /* Ready the display to receive data */
-      DOG_SPDR = 0;           /* Send zero to clear */
-      while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+      DOG_SPI_TRANSMIT(0);           /* Send zero to clear */
     }
     /* Now that the end line (page) was reached, we must advance to the next
      * page. Note that we did not need to advance the column address manually;
      * the LCD controller does that automatically. Again, picture an old
-     * typewriter whose carriage must be returned upon reaching the end of a
-     * line. Now that we've reached the end of line, we must reset the carriage
-     * (column) back to the left side of the display. This takes two commands.
+     * typewriter whose carriage must be returned at the start of each line;
+     * this is done by the two column address commands above.
      */
-    DOG_SEND_COMMAND(); /* Ready display to receive commands */
-    DOG_SPDR = 0x10;        /* Send upper column address, 0*/
-    while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
-    DOG_SPDR = 0x00;        /* Send lower column address, 0*/
-    while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
   }
   
   DOG_SEND_COMMAND();   /* Ready the display to receive a command */
-  DOG_SPDR = 0xB0;          /* Go back to 0th page */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+  DOG_SPI_TRANSMIT(0xB0);          /* Go back to 0th page */
 
   DOG_SLAVE_DESELECT();     /* Deselect the screen */
+
+  dog_dirty_set_all(&dog_main_dirty);   /* Screen no longer matches buffer */
 }
 
 void dog_print_buffer(void)
 {
   /* start off in top-left corner */
   uint8_t page = 0;
-  uint8_t col = 0;
+  uint8_t block;
+  uint8_t strip[8];
+
+  DOG_STAT_FLUSH_BEGIN();
 
   /* Select the screen */
   DOG_SLAVE_SELECT();
@@ -157,35 +223,40 @@ void dog_print_buffer(void)
   /* Loop across all pages. Picture each page as a line on a typewriter */
   for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
   {
-    DOG_SEND_COMMAND();            /* Ready display to receive commands */
-    DOG_SPDR = 0xB0 | page;            /* Send over page number to be written */
-    while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+    /* Send over page number to be written and return the carriage (column)
+     * to the left side of the display.
+     */
+    dog_set_address(page, 0);
 
-    /* Loop across all columns until the page (line) is filled */
-    for(col = 0; col < DOG_WIDTH; ++col)
+    if(dog_orientation >= DOG_ORIENT_90)
     {
-      DOG_SEND_DATA();                 /* Ready the display to receive data */
-      DOG_SPDR = dog_buffer[page][col];    /* Send buffer data */
-      while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+      /* Portrait: each 8 x 8 block of the page is a transposed block of
+       * the buffer, which holds 16 pages of 64 columns.
+       */
+      for(block = 0; block < DOG_WIDTH / 8; ++block)
+      {
+        dog_transpose8x8(&dog_main_buffer[0][0] + block * DOG_HEIGHT + page * 8,
+                         strip);
+        dog_spi_send_data(strip, 8);
+      }
+    }
+    else
+    {
+      /* Send the whole page (line) in one pipelined run */
+      dog_spi_send_data(dog_main_buffer[page], DOG_WIDTH);
     }
     /* Now that the end line (page) was reached, we must advance to the next
      * page. Note that we did not need to advance the column address manually;
-     * the LCD controller does that automatically. Again, picture an old
-     * typewriter whose carriage must be returned upon reaching the end of a
-     * line. Now that we've reached the end of line, we must reset the carriage
-     * (column) back to the left side of the display. This takes two commands.
+     * the LCD controller does that automatically.
      */
-    DOG_SEND_COMMAND();            /* Ready display to receive commands */
-    DOG_SPDR = 0x10;                         /* Send upper column address, 0*/
-    while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
-    DOG_SPDR = 0x00;                         /* Send lower column address, 0*/
-    while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
   }
   DOG_SEND_COMMAND();         /* Ready the display to receive a command */
-  DOG_SPDR = 0xB0;                                   /* Go back to 0th page */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+  DOG_SPI_TRANSMIT(0xB0);                                   /* Go back to 0th page */
 
   DOG_SLAVE_DESELECT();                             /* Deselect the screen */
+
+  dog_dirty_reset(&dog_main_dirty);          /* Screen now matches buffer */
+  DOG_STAT_FLUSH_END();
 }
 
 void dog_clear_buffer(void)
@@ -203,6 +274,8 @@ void dog_clear_buffer(void)
       dog_buffer[page][col] = 0;    /* Send buffer data */
     }
   }
+  DOG_STAT_ADD(buffer_bytes, DOG_PAGE_HEIGHT * DOG_WIDTH);
+  dog_dirty_set_all(dog_dirty);
 }
 
 void dog_set_contrast(uint8_t contrast)
@@ -215,11 +288,9 @@ void dog_set_contrast(uint8_t contrast)
   
   /* Contrast adjustment must be done in 2 SPI writes */
   
-  DOG_SPDR = 0x81;                   /* Send Command to adjust contrast */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+  DOG_SPI_TRANSMIT(0x81);                   /* Send Command to adjust contrast */
 
-  DOG_SPDR = contrast;               /* Adjust contrast */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
+  DOG_SPI_TRANSMIT(contrast);               /* Adjust contrast */
   
   DOG_SLAVE_DESELECT();              /* Deselect the screen */
 }
@@ -231,10 +302,9 @@ void dog_invert_pixels(dog_display_mode_t display_mode)
   DOG_SEND_COMMAND();            /* Ready display to receive commands */
   
   display_mode &= 1;             /* mask out all but LSB */
-  DOG_SPDR = (0xA6 | display_mode);  /* display_mode = 0 => DOG_NORMAL_DISPLAY. 
+  DOG_SPI_TRANSMIT((0xA6 | display_mode));  /* display_mode = 0 => DOG_NORMAL_DISPLAY. 
                                   * display_mode = 1 => inverted display. 
                                   */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
   
   DOG_SLAVE_DESELECT();              /* Deselect the screen */
 
@@ -246,12 +316,306 @@ void dog_power(dog_power_state_t state)
   DOG_SLAVE_SELECT();                /* Select the LCD */
   DOG_SEND_COMMAND();            /* Ready display to receive commands */
   
-  DOG_SPDR = (0xAE | state);          /* state = 0 => off. 
+  DOG_SPI_TRANSMIT((0xAE | state));          /* state = 0 => off. 
                                   * stae = 1 => on. 
                                   */
-  while (!(DOG_SPSR & (1<<DOG_SPIF_BIT)));
   
   DOG_SLAVE_DESELECT();              /* Deselect the screen */
 
 }
 
+void dog_set_draw_target(uint8_t (*buffer)[DOG_WIDTH], dog_dirty_t *dirty)
+{
+  dog_buffer = buffer;
+  dog_dirty = dirty;
+}
+
+void dog_invalidate(const dog_span_t *span)
+{
+  uint8_t page;
+
+  for(page = span->page_start; page <= span->page_end; ++page)
+  {
+    if(span->col_start < dog_dirty->first[page]) 
+      dog_dirty->first[page] = span->col_start;
+    if(span->col_end > dog_dirty->last[page])
+      dog_dirty->last[page] = span->col_end;
+  }
+}
+
+void dog_dirty_reset(dog_dirty_t *dirty)
+{
+  uint8_t page;
+
+  for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+  {
+    dirty->first[page] = DOG_WIDTH;
+    dirty->last[page] = 0;
+  }
+}
+
+void dog_dirty_set_all(dog_dirty_t *dirty)
+{
+  uint8_t page;
+
+  for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+  {
+    dirty->first[page] = 0;
+    dirty->last[page] = DOG_WIDTH - 1;
+  }
+}
+
+void dog_set_address(uint8_t page, uint8_t col)
+{
+  DOG_SEND_COMMAND();                /* Ready display to receive commands */
+  DOG_SPI_TRANSMIT(0xB0 | page);                 /* Page address */
+  col += dog_column_offset;             /* Skip hidden columns if needed */
+  DOG_SPI_TRANSMIT(0x10 | (col >> 4));           /* Upper column address */
+  DOG_SPI_TRANSMIT(col & 0x0F);                  /* Lower column address */
+}
+
+int8_t dog_set_orientation(dog_orientation_t orientation)
+{
+  if(orientation > DOG_ORIENT_270) return -1;  /* Would index past the tables */
+
+  dog_orientation = orientation;
+
+  /* Only the orientations which keep the ADC normal need the offset */
+  dog_column_offset = (orientation_adc[orientation] == 0xA0) ? 
+                      DOG_ADC_NORMAL_OFFSET : 0;
+
+  if(orientation >= DOG_ORIENT_90)
+  {
+    dog_width = DOG_HEIGHT;
+    dog_height = DOG_WIDTH;
+  }
+  else
+  {
+    dog_width = DOG_WIDTH;
+    dog_height = DOG_HEIGHT;
+  }
+
+  DOG_SLAVE_SELECT();                /* Select the LCD */
+  DOG_SEND_COMMAND();            /* Ready display to receive commands */
+  DOG_SPI_TRANSMIT(orientation_adc[orientation]);    /* Segment direction */
+  DOG_SPI_TRANSMIT(orientation_com[orientation]);    /* Common direction */
+  DOG_SLAVE_DESELECT();              /* Deselect the screen */
+
+  dog_dirty_set_all(&dog_main_dirty);   /* Screen no longer matches buffer */
+  return 0;
+}
+
+void dog_transpose8x8(const uint8_t *in, uint8_t *out)
+{
+  uint32_t x, y, t;
+
+  /* Rows 7..4 in x and 3..0 in y, highest row in the top byte */
+  x = ((uint32_t)in[7] << 24) | ((uint32_t)in[6] << 16) |
+      ((uint32_t)in[5] << 8)  |  (uint32_t)in[4];
+  y = ((uint32_t)in[3] << 24) | ((uint32_t)in[2] << 16) |
+      ((uint32_t)in[1] << 8)  |  (uint32_t)in[0];
+
+  /* Swap the off-diagonal bits of every 2 x 2 block */
+  t = (x ^ (x >> 7)) & 0x00AA00AAUL;  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AAUL;  y = y ^ t ^ (t << 7);
+
+  /* ... of every 4 x 4 block */
+  t = (x ^ (x >> 14)) & 0x0000CCCCUL; x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCCUL; y = y ^ t ^ (t << 14);
+
+  /* ... and of the 8 x 8 block, which straddles x and y */
+  t = (x & 0xF0F0F0F0UL) | ((y >> 4) & 0x0F0F0F0FUL);
+  y = ((x << 4) & 0xF0F0F0F0UL) | (y & 0x0F0F0F0FUL);
+  x = t;
+
+  out[7] = x >> 24; out[6] = x >> 16; out[5] = x >> 8; out[4] = x;
+  out[3] = y >> 24; out[2] = y >> 16; out[1] = y >> 8; out[0] = y;
+}
+
+#if DOG_TRANSPORT == DOG_TRANSPORT_BITBANG
+
+void dog_spi_send_data(const uint8_t *data, uint8_t count)
+{
+  uint8_t blocks;
+
+  if(!count) return;
+  DOG_SEND_DATA();                      /* A0 stays high for the whole run */
+  DOG_STAT_ADD(spi_bytes, count);
+
+  for(blocks = count >> 3; blocks; --blocks)
+  {
+    DOG_BITBANG_TRANSMIT(data[0]); DOG_BITBANG_TRANSMIT(data[1]);
+    DOG_BITBANG_TRANSMIT(data[2]); DOG_BITBANG_TRANSMIT(data[3]);
+    DOG_BITBANG_TRANSMIT(data[4]); DOG_BITBANG_TRANSMIT(data[5]);
+    DOG_BITBANG_TRANSMIT(data[6]); DOG_BITBANG_TRANSMIT(data[7]);
+    data += 8;
+  }
+  for(count &= 7; count; --count)
+  {
+    DOG_BITBANG_TRANSMIT(*data++);
+  }
+}
+
+int8_t dog_spi_configure(const dog_spi_config_t *config)
+{
+  CLEARBIT(DOG_SCK_PORT, DOG_SCK_PIN);            /* Clock idles low */
+  return (config->bit_order == DOG_MSB_FIRST) ? 0 : -1;
+}
+
+uint8_t dog_spi_autotune(uint32_t f_cpu)
+{
+  (void)f_cpu;
+
+  dog_spi_configure(&dog_spi_default_config);
+  return 0;                         /* The clock is set by the CPU speed */
+}
+
+#elif DOG_TRANSPORT == DOG_TRANSPORT_SPI
+
+void dog_spi_send_data(const uint8_t *data, uint8_t count)
+{
+  uint8_t next, blocks;
+
+  if(!count) return;
+  DOG_SEND_DATA();                      /* A0 stays high for the whole run */
+  DOG_STAT_ADD(spi_bytes, count);
+
+#if DOG_BITBANG_FALLBACK
+  if(dog_spi_bitbang)
+  {
+    while(count--) dog_bitbang_transmit(*data++);
+    return;
+  }
+#endif /* DOG_BITBANG_FALLBACK */
+
+/* Fetch the next byte while the current one shifts, then hand it over */
+#define DOG_PIPELINE_STEP()  next = *data++; DOG_SPI_WAIT(); DOG_SPDR = next;
+
+  DOG_SPDR = *data++;                   /* Start the first byte */
+  --count;
+
+  for(blocks = count >> 3; blocks; --blocks)
+  {
+    DOG_PIPELINE_STEP(); DOG_PIPELINE_STEP();
+    DOG_PIPELINE_STEP(); DOG_PIPELINE_STEP();
+    DOG_PIPELINE_STEP(); DOG_PIPELINE_STEP();
+    DOG_PIPELINE_STEP(); DOG_PIPELINE_STEP();
+  }
+  for(count &= 7; count; --count)
+  {
+    DOG_PIPELINE_STEP();
+  }
+
+#undef DOG_PIPELINE_STEP
+
+  DOG_SPI_WAIT();               /* Let the last byte finish before A0 moves */
+}
+
+int8_t dog_spi_configure(const dog_spi_config_t *config)
+{
+  uint8_t rate, double_speed;
+
+  if(config->bitbang)
+  {
+#if DOG_BITBANG_FALLBACK
+    DOG_SPCR = 0;                    /* Release the pins from the SPI block */
+    CLEARBIT(DOG_SCK_PORT, DOG_SCK_PIN);          /* Clock idles low */
+    bitbang_order = config->bit_order;
+    dog_spi_bitbang = 1;
+    return 0;
+#else
+    return -1;
+#endif /* DOG_BITBANG_FALLBACK */
+  }
+
+  /* Translate the divider into SPR1:SPR0 and SPR2X */
+  switch(config->divider)
+  {
+  case 2:   rate = 0; double_speed = 1; break;
+  case 4:   rate = 0; double_speed = 0; break;
+  case 8:   rate = 1; double_speed = 1; break;
+  case 16:  rate = 1; double_speed = 0; break;
+  case 32:  rate = 2; double_speed = 1; break;
+  case 64:  rate = 2; double_speed = 0; break;
+  case 128: rate = 3; double_speed = 0; break;
+  default:  return -1;
+  }
+#if !DOG_HAS_SPR2X
+  if(double_speed) return -1;
+#endif
+
+  DOG_SPCR = ((0 << DOG_SPIE) |
+              (1 << DOG_SPE)  |
+              ((config->bit_order == DOG_LSB_FIRST) << DOG_DORD) |
+              (1 << DOG_MSTR) |
+              (0 << DOG_CPOL) |
+              (0 << DOG_CPHA) |
+              (((rate >> 1) & 1) << DOG_SPR1) |
+              ((rate & 1) << DOG_SPR0));
+#if DOG_HAS_SPR2X
+  if(double_speed)
+    SETBIT(DOG_SPSR, DOG_SPR2X);
+  else
+    CLEARBIT(DOG_SPSR, DOG_SPR2X);
+#endif
+
+  dog_spi_bitbang = 0;
+  return 0;
+}
+
+uint8_t dog_spi_autotune(uint32_t f_cpu)
+{
+  dog_spi_config_t config;
+  uint8_t divider;
+
+  config.bit_order = DOG_MSB_FIRST;
+  config.bitbang = 0;
+
+  /* Walk up the dividers until SCK is slow enough for the DOG module */
+  for(divider = 2; divider < 128; divider <<= 1)
+  {
+#if !DOG_HAS_SPR2X
+    if(divider == 2 || divider == 8 || divider == 32) continue;
+#endif
+    if(f_cpu / divider <= DOG_MAX_SCK_HZ) break;
+  }
+
+  config.divider = divider;
+  dog_spi_configure(&config);
+  return divider;
+}
+
+#endif /* DOG_TRANSPORT */
+
+#if DOG_TRANSPORT != DOG_TRANSPORT_LINUX
+
+void dog_bitbang_transmit(uint8_t byte)
+{
+  uint8_t i;
+
+  if(bitbang_order == DOG_MSB_FIRST)
+  {
+    DOG_BITBANG_TRANSMIT(byte);
+    return;
+  }
+
+  /* SPI mode 0: data is set up while SCK is low and sampled on the rise */
+  for(i = 0; i < 8; ++i, byte >>= 1)
+  {
+    DOG_BITBANG_BIT(byte, 0)
+  }
+}
+
+#endif /* DOG_TRANSPORT != DOG_TRANSPORT_LINUX */
+
+#if DOG_STATS
+void dog_stats_reset(void)
+{
+  dog_stats.pixels = 0;
+  dog_stats.buffer_bytes = 0;
+  dog_stats.spi_bytes = 0;
+  dog_stats.busy_waits = 0;
+  dog_stats.flushes = 0;
+  dog_stats.flush_ticks = 0;
+}
+#endif /* DOG_STATS */
@@ -37,6 +37,10 @@
 #define DOG_HEIGHT 64
 /** Height of a single page in pixels */
 #define DOG_PAGE_HEIGHT 8
+/** Width of the display RAM of the controller, visible or not */
+#define DOG_RAM_WIDTH 132
+/** Column address of the leftmost visible column when the ADC is normal */
+#define DOG_ADC_NORMAL_OFFSET 4
 
 /*----------------------------------------------------------------------------*/
 /* MACROS                                                                     */
@@ -51,39 +55,31 @@
 #define CLEARBIT(port,bit) ((port) &= ~(1 << (bit)))
 #endif /* CLEARBIT */
 
-/**Initialize SPI communication:                                           <BR>
- * SPIE  - SPI Interrupt DISABLED (we will poll instead)                   <BR>
- * SPE   - SPI ENABLED                                                     <BR>
- * DORD  - MSB First                                                       <BR>
- * MSTR  - Configured as a MASTER                                          <BR>
- * CPOL  - Clock Polarity = 0                                              <BR>
- * CPHA  - Clock Phase = 0                                                 <BR>
- * SPI Clock = f_clk/2          (EA DOGM128 can handle up to 20MHz)        <BR>
- * SPR1  - CLEARED                                                         <BR>
- * SPR0  - CLEARED                                                         <BR>
- * SPR2X - SET                  (When available)                           <BR>
- */                                                                        
-
-#ifdef DOG_SPR2X
-#define DOG_INIT_SPI() DOG_SPCR = ((0 << DOG_SPIE)|                        \
-                                  (1 << DOG_SPE)  |                        \
-                                  (0 << DORD)     |                        \
-                                  (1 << MSTR)     |                        \
-                                  (0 << DOG_CPOL) |                        \
-                                  (0 << DOG_CPHA) |                        \
-                                  (0 << DOG_SPR1) |                        \
-                                  (0 << DOG_SPR0));                        \
-                       SETBIT(DOG_SPSR, DOG_SPR2X);
+/** Initialize SPI communication with the settings in DOGM128_user_config.h;
+ *  see dog_spi_configure() for the register settings.
+ */
+#define DOG_INIT_SPI() dog_spi_configure(&dog_spi_default_config);
+
+#if DOG_TRANSPORT == DOG_TRANSPORT_LINUX
+
+/** Nothing to select; spidev drives chip select for every transfer */
+#define DOG_SLAVE_SELECT()
+/** Hand everything queued so far to the kernel */
+#define DOG_SLAVE_DESELECT() dog_linux_flush();
+/** Activate DOGM128 reset */    
+#define DOG_ASSERT_RESET() dog_linux_set_reset(0);
+/** Deactivate DOGM128 reset */
+#define DOG_UNASSERT_RESET() dog_linux_set_reset(1);
+/** Nothing to wait for; bytes are queued */
+#define DOG_SPI_WAIT()
+/** Queue one byte for the DOGM128 */
+#define DOG_SPI_SEND(byte) dog_linux_transmit(byte)
+/** Set A_0 pin; allows DOGM128 to receive data. */
+#define DOG_SEND_DATA() dog_linux_set_a0(1);
+/** Clear A_0 pin; allows DOGM128 to receive commands. */
+#define DOG_SEND_COMMAND() dog_linux_set_a0(0);
+
 #else
-#define DOG_INIT_SPI() DOG_SPCR = ((0 << DOG_SPIE) |                       \
-                                   (1 << DOG_SPE)  |                       \
-                                   (0 << DORD)     |                       \
-                                   (1 << MSTR)     |                       \
-                                   (0 << DOG_CPOL) |                       \
-                                   (0 << DOG_CPHA) |                       \
-                                   (0 << DOG_SPR1) |                       \
-                                   (0 << DOG_SPR0));                                            
-#endif
 
 /** Select the DOGM128 */
 #define DOG_SLAVE_SELECT() CLEARBIT(DOG_SPI_PORT, DOG_SS_BAR_PIN);
@@ -94,21 +90,103 @@
 /** Deactivate DOGM128 reset */
 #define DOG_UNASSERT_RESET() SETBIT(DOG_RESET_PORT, DOG_RESET_PIN); 
 
+/** Shift one bit of a byte out on MOSI and clock it into the DOGM128. With
+ *  constant ports and pins each line becomes a single set/clear instruction.
+ */
+#define DOG_BITBANG_BIT(byte, bit)                                         \
+        if((byte) & (1 << (bit))) SETBIT(DOG_MOSI_PORT, DOG_MOSI_PIN);     \
+        else CLEARBIT(DOG_MOSI_PORT, DOG_MOSI_PIN);                        \
+        SETBIT(DOG_SCK_PORT, DOG_SCK_PIN);                                 \
+        CLEARBIT(DOG_SCK_PORT, DOG_SCK_PIN);
+
+/** Transmit one byte to the DOGM128 in software, MSB first (SPI mode 0) */
+#define DOG_BITBANG_TRANSMIT(byte)                                         \
+        do { uint8_t dog_bb_byte = (byte);                                 \
+             DOG_BITBANG_BIT(dog_bb_byte, 7) DOG_BITBANG_BIT(dog_bb_byte, 6)\
+             DOG_BITBANG_BIT(dog_bb_byte, 5) DOG_BITBANG_BIT(dog_bb_byte, 4)\
+             DOG_BITBANG_BIT(dog_bb_byte, 3) DOG_BITBANG_BIT(dog_bb_byte, 2)\
+             DOG_BITBANG_BIT(dog_bb_byte, 1) DOG_BITBANG_BIT(dog_bb_byte, 0)\
+        } while(0)
+
+#if DOG_TRANSPORT == DOG_TRANSPORT_BITBANG
+
+/** Nothing to wait for; a bit-banged byte is complete once it is sent */
+#define DOG_SPI_WAIT()
+/** Transmit one byte to the DOGM128 */
+#define DOG_SPI_SEND(byte) DOG_BITBANG_TRANSMIT(byte)
+
+#else
+
+/** Wait for the SPI peripheral to finish shifting out the current byte */
+#define DOG_SPI_WAIT()                                                     \
+        while (!(DOG_SPSR & (1<<DOG_SPIF_BIT))) DOG_STAT_ADD(busy_waits, 1)
+
+/** Transmit one byte to the DOGM128 using the SPI peripheral and wait for
+ *  the transfer to finish.
+ */
+#define DOG_HW_SPI_TRANSMIT(byte)                                          \
+        do { DOG_SPDR = (byte); DOG_SPI_WAIT(); } while(0)
+
+/** Transmit one byte to the DOGM128 and wait for the transfer to finish */
+#if DOG_BITBANG_FALLBACK
+#define DOG_SPI_SEND(byte)                                             \
+        do { if(dog_spi_bitbang) dog_bitbang_transmit(byte);              \
+             else DOG_HW_SPI_TRANSMIT(byte); } while(0)
+#else
+#define DOG_SPI_SEND(byte)     DOG_HW_SPI_TRANSMIT(byte)
+#endif /* DOG_BITBANG_FALLBACK */
+
+#endif /* DOG_TRANSPORT == DOG_TRANSPORT_BITBANG */
+
 /** Set A_0 pin; allows DOGM128 to receive data. */
 #define DOG_SEND_DATA() \
         SETBIT(DOG_DATA_OR_COMMAND_PORT, DOG_DATA_OR_COMMAND_PIN);      
 /** Clear A_0 pin; allows DOGM128 to receive commands. */                        
 #define DOG_SEND_COMMAND() \
         CLEARBIT(DOG_DATA_OR_COMMAND_PORT, DOG_DATA_OR_COMMAND_PIN); 
+
+#endif /* DOG_TRANSPORT == DOG_TRANSPORT_LINUX */
+
+/** Transmit one byte to the DOGM128 through the selected transport */
+#define DOG_SPI_TRANSMIT(byte)                                             \
+        do { DOG_STAT_ADD(spi_bytes, 1); DOG_SPI_SEND(byte); } while(0)
+
+#if DOG_STATS
+/** Add to one of the counters of @b dog_stats */
+#define DOG_STAT_ADD(counter, n) (dog_stats.counter += (n))
+/** Start timing a flush */
+#define DOG_STAT_FLUSH_BEGIN() (dog_stats_flush_start = DOG_GET_TICKS())
+/** Count a flush and the ticks it took */
+#define DOG_STAT_FLUSH_END()                                               \
+        (dog_stats.flushes++,                                              \
+         dog_stats.flush_ticks += DOG_GET_TICKS() - dog_stats_flush_start)
+#else
+#define DOG_STAT_ADD(counter, n)
+#define DOG_STAT_FLUSH_BEGIN()
+#define DOG_STAT_FLUSH_END()
+#endif /* DOG_STATS */
+
+/** Extend the dirty region of the current draw target to include a single
+ *  byte of the buffer.
+ */
+#define DOG_MARK_DIRTY(page, col)                                          \
+        { if((col) < dog_dirty->first[page]) dog_dirty->first[page] = (col);\
+          if((col) > dog_dirty->last[page])  dog_dirty->last[page] = (col); }
         
 /*----------------------------------------------------------------------------*/
 /* TYPEDEFS                                                                   */
 /*----------------------------------------------------------------------------*/
 
+#if DOG_USE_STDINT
+#include <stdint.h>
+#else
 typedef unsigned char  uint8_t    /** portable 8-bit unsigned integer */  ;
 typedef signed char     int8_t    /** portable 8-bit signed integer */    ;
 typedef unsigned int  uint16_t    /** portable 16-bit unsigned integer */ ;
 typedef signed int     int16_t    /** portable 16-bit signed integer */   ;
+typedef unsigned long uint32_t    /** portable 32-bit unsigned integer */ ;
+typedef signed long    int32_t    /** portable 32-bit signed integer */   ;
+#endif /* DOG_USE_STDINT */
 
 /** used for power-on and power off */
 typedef enum{DOG_OFF = 0, DOG_ON} dog_power_state_t;
@@ -116,6 +194,119 @@ typedef enum{DOG_OFF = 0, DOG_ON} dog_power_state_t;
 /** used for display mode */
 typedef enum{DOG_NORMAL_DISPLAY = 0, DOG_INVERTED_DISPLAY} dog_display_mode_t;
 
+/** used for the order in which the bits of a byte are shifted out */
+typedef enum{DOG_MSB_FIRST = 0, DOG_LSB_FIRST} dog_bit_order_t;
+
+/** used to select how the buffer is mapped onto the glass. (x,y) is a
+ *  position in the buffer; the landscape position it appears at, as seen
+ *  with the module mounted for 6:00 viewing, is given for each mode.
+ */
+typedef enum
+{
+  DOG_ORIENT_0 = 0,     /**< (x, y)                                   */
+  DOG_ORIENT_180,       /**< (127 - x, 63 - y)                        */
+  DOG_ORIENT_MIRROR_X,  /**< (127 - x, y)                             */
+  DOG_ORIENT_MIRROR_Y,  /**< (x, 63 - y)                              */
+  DOG_ORIENT_90,        /**< (y, 63 - x); portrait, 64 x 128 pixels   */
+  DOG_ORIENT_270        /**< (127 - y, x); portrait, 64 x 128 pixels  */
+} dog_orientation_t;
+
+/** used to configure the SPI transport at run time */
+typedef struct
+{
+  uint8_t divider;            /**< SCK = f_clk / divider: 2,4,...,128     */
+  dog_bit_order_t bit_order;  /**< DOG_MSB_FIRST for the DOG module       */
+  uint8_t bitbang;            /**< 1 to shift bytes out in software       */
+} dog_spi_config_t;
+
+/** used to describe a region of the buffer in pages and columns. A span is
+ *  inclusive on both ends, so a single byte of the buffer is described by
+ *  page_start == page_end and col_start == col_end.
+ */
+typedef struct
+{
+  uint8_t page_start;   /**< first page of the region [0,7]      */
+  uint8_t page_end;     /**< last page of the region [0,7]       */
+  uint8_t col_start;    /**< first column of the region [0,127]  */
+  uint8_t col_end;      /**< last column of the region [0,127]   */
+} dog_span_t;
+
+/** used to track which part of a buffer changed since it was last sent to the
+ *  display. Each page keeps the first and last column that changed; a page
+ *  whose first column is greater than its last column is clean.
+ */
+typedef struct
+{
+  uint8_t first[DOG_PAGE_HEIGHT];  /**< first changed column of each page */
+  uint8_t last[DOG_PAGE_HEIGHT];   /**< last changed column of each page  */
+} dog_dirty_t;
+
+/** Initializer for a dog_dirty_t with all pages clean */
+#define DOG_DIRTY_CLEAN                                                    \
+        { {DOG_WIDTH, DOG_WIDTH, DOG_WIDTH, DOG_WIDTH,                     \
+           DOG_WIDTH, DOG_WIDTH, DOG_WIDTH, DOG_WIDTH},                    \
+          {0, 0, 0, 0, 0, 0, 0, 0} }
+
+/** Initializer for a dog_dirty_t covering every column of every page */
+#define DOG_DIRTY_ALL                                                      \
+        { {0, 0, 0, 0, 0, 0, 0, 0},                                        \
+          {DOG_WIDTH - 1, DOG_WIDTH - 1, DOG_WIDTH - 1, DOG_WIDTH - 1,     \
+           DOG_WIDTH - 1, DOG_WIDTH - 1, DOG_WIDTH - 1, DOG_WIDTH - 1} }
+
+/** used to report where the time of the display subsystem goes */
+typedef struct
+{
+  uint32_t pixels;        /**< pixels set or cleared by dog_draw_pixel()  */
+  uint32_t buffer_bytes;  /**< bytes written to the draw target            */
+  uint32_t spi_bytes;     /**< bytes sent to the DOG module                */
+  uint32_t busy_waits;    /**< iterations spent polling the SPIF bit       */
+  uint32_t flushes;       /**< buffer flushes sent to the display          */
+  uint32_t flush_ticks;   /**< DOG_GET_TICKS() ticks spent in flushes      */
+} dog_stats_t;
+
+/*----------------------------------------------------------------------------*/
+/* EXTERNAL DATA                                                              */
+/*----------------------------------------------------------------------------*/
+/** Buffer holding the screen contents; @b dog_buffer points here unless
+ *  another draw target has been selected.
+ */
+extern uint8_t dog_main_buffer[DOG_PAGE_HEIGHT][DOG_WIDTH];
+
+/** Dirty region of @b dog_main_buffer */
+extern dog_dirty_t dog_main_dirty;
+
+/** Draw target: the buffer all drawing functions write to */
+extern uint8_t (*dog_buffer)[DOG_WIDTH];
+
+/** Dirty region of the draw target */
+extern dog_dirty_t *dog_dirty;
+
+/** SPI configuration applied by dog_init() */
+extern const dog_spi_config_t dog_spi_default_config;
+
+/** Set while the transport shifts bytes out in software */
+extern uint8_t dog_spi_bitbang;
+
+/** Orientation selected with dog_set_orientation() */
+extern dog_orientation_t dog_orientation;
+
+/** Width of the drawing area in pixels for the current orientation */
+extern uint8_t dog_width;
+
+/** Height of the drawing area in pixels for the current orientation */
+extern uint8_t dog_height;
+
+/** Offset added to every column address sent to the DOG module */
+extern uint8_t dog_column_offset;
+
+#if DOG_STATS
+/** Counters collected while @b DOG_STATS is set */
+extern dog_stats_t dog_stats;
+
+/** Tick count at the start of the flush being timed */
+extern uint32_t dog_stats_flush_start;
+#endif /* DOG_STATS */
+
 /*----------------------------------------------------------------------------*/
 /* FUNCTIONS                                                                  */
 /*----------------------------------------------------------------------------*/
@@ -170,7 +361,8 @@ void dog_clear_display(void);
  *
  *  @par Algorithm
  *       The function simply advances through the two-dimensional array which
- *       makes up the buffer and sets its contents equal to zero. 
+ *       makes up the draw target and sets its contents equal to zero. The
+ *       whole buffer is then marked dirty.
  *
  *  @par Assumptions
  *       - None
@@ -179,7 +371,8 @@ void dog_clear_display(void);
 void dog_clear_buffer(void);
 
 /** This function is used to print the entire contents of the buffer to the
- *  display.
+ *  display. It always sends @b dog_main_buffer, regardless of the draw
+ *  target, and marks it clean afterwards.
  *
  *  @par Algorithm
  *       Beginning at page 0, column 0, the function mimics an old typewriter
@@ -244,5 +437,205 @@ void dog_invert_pixels(dog_display_mode_t display_mode);
  */
 void dog_power(dog_power_state_t state);
 
+/** This function is used to select the buffer that all drawing functions 
+ *  write to. Modules such as layers use it to redirect drawing into their own
+ *  buffers; passing @b dog_main_buffer and @b dog_main_dirty restores the
+ *  default target.
+ *
+ *  @par Parameters
+ *         - @a buffer = The new draw target.
+ *         - @a dirty  = The dirty region belonging to @a buffer.
+ *
+ *  @par Assumptions
+ *       - None
+ */
+void dog_set_draw_target(uint8_t (*buffer)[DOG_WIDTH], dog_dirty_t *dirty);
+
+/** This function is used to mark a region of the draw target as changed. The
+ *  drawing functions in this library mark what they draw themselves; this
+ *  function is for code which writes to @b dog_buffer directly.
+ *
+ *  @par Parameters
+ *         - @a span = The region that changed.
+ *
+ *  @par Assumptions
+ *       - @a span lies within the display.
+ */
+void dog_invalidate(const dog_span_t *span);
+
+/** This function is used to mark a dirty region as entirely clean.
+ *
+ *  @par Parameters
+ *         - @a dirty = The dirty region to be reset.
+ */
+void dog_dirty_reset(dog_dirty_t *dirty);
+
+/** This function is used to mark a dirty region as entirely dirty.
+ *
+ *  @par Parameters
+ *         - @a dirty = The dirty region to be set.
+ */
+void dog_dirty_set_all(dog_dirty_t *dirty);
+
+/** This function is used to set the page and column address at which the
+ *  next data byte sent to the DOG module will be written.
+ *
+ *  @par Parameters
+ *         - @a page = The page address [0,7].
+ *         - @a col  = The column address [0,127].
+ *
+ *  @par Algorithm
+ *       Sends the page address command followed by the two column address
+ *       commands, adding @b dog_column_offset to @a col. The A0 line is left
+ *       in command mode.
+ *
+ *  @par Assumptions
+ *       - The DOG module has been selected with DOG_SLAVE_SELECT().
+ */
+void dog_set_address(uint8_t page, uint8_t col);
+
+/** This function is used to change how the buffer is mapped onto the glass,
+ *  e.g. for a panel mounted upside down or in portrait.
+ *
+ *  @par Parameters
+ *         - @a orientation = One of the modes of dog_orientation_t.
+ *
+ *  @par Algorithm
+ *       Mirroring and 180 degrees cost nothing per pixel: they are done by
+ *       the controller, by selecting the segment (ADC, 0xA0/0xA1) and common
+ *       output (0xC0/0xC8) scan directions. With the ADC normal, the visible
+ *       columns start at address 4, which is taken care of through
+ *       @b dog_column_offset. The portrait modes store the buffer as 16 pages
+ *       of 64 columns; dog_print_buffer() turns it into the controller's
+ *       layout with dog_transpose8x8(), one 8 x 8 block at a time, and a
+ *       mirror in the controller completes the rotation. @b dog_width and
+ *       @b dog_height are swapped accordingly and the main buffer is marked
+ *       dirty.
+ *
+ *  @par Assumptions
+ *       - The user has called the dog_init() function. Otherwise the
+ *         orientation is applied by dog_init().
+ *       - In portrait, only the pixel-based functions (pixels, points, lines,
+ *         rectangles and arcs) may be used, and the buffer is sent with
+ *         dog_print_buffer(). Characters, layers and incremental updates
+ *         work on the landscape layout.
+ *       - dog_update_invalidate() is called afterwards when incremental
+ *         updates are used.
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise
+ *           (@a orientation is not one of the modes) it returns -1 and
+ *           nothing is changed.
+ */
+int8_t dog_set_orientation(dog_orientation_t orientation);
+
+/** This function is used to transpose an 8 x 8 bit matrix: bit @a i of
+ *  @a out[j] is set to bit @a j of @a in[i]. This turns 8 page-major bytes
+ *  (vertical strips) into 8 row-major bytes (horizontal strips), and back.
+ *
+ *  @par Parameters
+ *         - @a in  = The 8 bytes of the matrix.
+ *         - @a out = Receives the 8 bytes of the transposed matrix. Must not
+ *                    overlap @a in.
+ *
+ *  @par Algorithm
+ *       The matrix is held in two 32-bit words and transposed in three
+ *       rounds of masked swaps (2 x 2, 4 x 4 and 8 x 8 blocks), instead of
+ *       moving the 64 bits one at a time.
+ */
+void dog_transpose8x8(const uint8_t *in, uint8_t *out);
+
+/** This function is used to send a run of data bytes to the display as fast
+ *  as the SPI clock allows.
+ *
+ *  @par Parameters
+ *         - @a data  = The bytes to be sent.
+ *         - @a count = The number of bytes to be sent.
+ *
+ *  @par Algorithm
+ *       A0 is raised once for the whole run. Each byte is fetched while the
+ *       previous one is still being shifted out, so that only the store to
+ *       the data register remains between the end of one transfer and the
+ *       start of the next. The loop is unrolled eight times to keep the loop
+ *       overhead out of the critical path. When bit-banging, the bytes are
+ *       simply sent one after another (unrolled the same way with
+ *       @b DOG_TRANSPORT_BITBANG).
+ *
+ *  @par Assumptions
+ *       - The DOG module has been selected with DOG_SLAVE_SELECT() and the
+ *         page and column address have been set.
+ *       - No SPI transfer is in progress.
+ */
+void dog_spi_send_data(const uint8_t *data, uint8_t count);
+
+#if DOG_STATS
+/** This function is used to set every counter of @b dog_stats back to zero.
+ *  Only available when @b DOG_STATS is set; the counters are compiled out
+ *  otherwise.
+ */
+void dog_stats_reset(void);
+#endif /* DOG_STATS */
+
+/** This function is used to change the SPI settings at run time. dog_init()
+ *  applies @b dog_spi_default_config, built from DOGM128_user_config.h.
+ *
+ *  @par Parameters
+ *         - @a config = The new settings.
+ *
+ *  @par Algorithm
+ *       The divider is translated into the SPR1, SPR0 and SPR2X bits; 
+ *       dividers of 2, 8 and 32 require SPR2X. The SPI peripheral is then
+ *       set up as follows:                                               <BR>
+ *       SPIE  - SPI Interrupt DISABLED (we will poll instead)            <BR>
+ *       SPE   - SPI ENABLED (DISABLED when bit-banging)                  <BR>
+ *       DORD  - According to @a config->bit_order                        <BR>
+ *       MSTR  - Configured as a MASTER                                   <BR>
+ *       CPOL  - Clock Polarity = 0                                       <BR>
+ *       CPHA  - Clock Phase = 0                                          <BR>
+ *       When bit-banging, SCK and MOSI are driven as plain port pins and
+ *       the divider is ignored. With @b DOG_TRANSPORT_BITBANG only the SCK
+ *       pin is set up, and only MSB first is supported.
+ *
+ *  @par Assumptions
+ *       - The SCK and MOSI pins have been configured as outputs.
+ *
+ *  @returns Upon successful completion, the function returns zero. It returns
+ *           -1 if the divider is not supported by the MCU (or bit-banging
+ *           was requested without @b DOG_BITBANG_FALLBACK).
+ */
+int8_t dog_spi_configure(const dog_spi_config_t *config);
+
+/** This function is used to select the fastest SPI clock the DOG module and
+ *  the MCU support.
+ *
+ *  @par Parameters
+ *         - @a f_cpu = The clock frequency of the MCU in Hz.
+ *
+ *  @par Algorithm
+ *       Picks the smallest divider for which f_cpu / divider does not exceed
+ *       @b DOG_MAX_SCK_HZ, skipping the dividers which need SPR2X when the
+ *       MCU lacks it, and applies it with dog_spi_configure() (MSB first,
+ *       hardware SPI).
+ *
+ *  @par Assumptions
+ *       - None
+ *
+ *  @returns The divider that was selected, or zero with
+ *           @b DOG_TRANSPORT_BITBANG.
+ */
+uint8_t dog_spi_autotune(uint32_t f_cpu);
+
+/** This function is used to shift a byte out in software. It is called by
+ *  DOG_SPI_TRANSMIT() while bit-banging is selected and should not normally
+ *  be called directly.
+ *
+ *  @par Parameters
+ *         - @a byte = The byte to be sent.
+ */
+void dog_bitbang_transmit(uint8_t byte);
+
+#if DOG_TRANSPORT == DOG_TRANSPORT_LINUX
+#include "DOGM128_linux.h"
+#endif
+
 #endif /* DOGM128_COMMON_H */
 /** @} */ /* DOGM128_common */
\ No newline at end of file
@@ -22,6 +22,9 @@
  * DOGM128_characters.h   
  * - DOGM128_common.h
  *
+ * DOGM128_numeric.h
+ * - DOGM128_characters.h
+ *
  * DOGM128_pixel.h
  * - DOGM128_common.h
  *
@@ -39,6 +42,49 @@
  * - DOGM128_point.h                               
  * - DOGM128_lines.h
  *
+ * DOGM128_scroll.h
+ * - DOGM128_common.h
+ *
+ * DOGM128_save.h
+ * - DOGM128_common.h
+ *
+ * DOGM128_bar.h
+ * - DOGM128_common.h
+ *
+ * DOGM128_gauge.h
+ * - DOGM128_common.h
+ *
+ * DOGM128_chart.h
+ * - DOGM128_common.h
+ *
+ * DOGM128_menu.h
+ * - DOGM128_common.h
+ *
+ * DOGM128_remote.h
+ * - DOGM128_common.h
+ *
+ * DOGM128_layer.h
+ * - DOGM128_common.h
+ *
+ * DOGM128_update.h
+ * - DOGM128_common.h
+ *
+ * DOGM128_rows.h
+ * - DOGM128_common.h
+ *
+ * DOGM128_gray.h
+ * - DOGM128_common.h
+ *
+ * DOGM128_frame.h
+ * - DOGM128_common.h
+ *
+ * DOGM128_linux.h          \n(only with DOG_TRANSPORT_LINUX; included by
+ *                            DOGM128_common.h)
+ * - DOGM128_common.h
+ *
+ * DOGM128_emulator.h       \n(host builds only; not included here)
+ * - DOGM128_common.h
+ *
  * This relationship is further illustrated by the diagram below:
  * @image html DOGM128-hierarchy.png "EA DOGM128 Library File Hierarchy"
  */
@@ -52,11 +98,24 @@
 /*----------------------------------------------------------------------------*/
 #include "DOGM128_common.h"
 #include "DOGM128_characters.h"
+#include "DOGM128_numeric.h"
 #include "DOGM128_pixel.h"
 #include "DOGM128_lines.h"
 #include "DOGM128_point.h"
 #include "DOGM128_rectangle.h"
 #include "DOGM128_arc.h"
+#include "DOGM128_scroll.h"
+#include "DOGM128_save.h"
+#include "DOGM128_bar.h"
+#include "DOGM128_gauge.h"
+#include "DOGM128_chart.h"
+#include "DOGM128_menu.h"
+#include "DOGM128_layer.h"
+#include "DOGM128_update.h"
+#include "DOGM128_rows.h"
+#include "DOGM128_gray.h"
+#include "DOGM128_frame.h"
+#include "DOGM128_remote.h"
 
 #endif /* DOGM128_DRIVER_ATMEGA128_H */
 
@@ -0,0 +1,299 @@
+/*
+ * @file   DOGM128_emulator.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for an emulated ST7565R controller. <br>
+ * @defgroup DOGM128_emulator_source
+ * @{
+ *
+ * This file contains the source code for the functions described in
+ * emulator.h. It is meant for host builds only; the user should not include
+ * it in a microcontroller project.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "DOGM128_emulator.h"
+
+#if DOG_TRANSPORT == DOG_TRANSPORT_LINUX
+#include <unistd.h>
+#include <linux/gpio.h>
+#include <linux/spi/spidev.h>
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to decode a single command byte.
+ *
+ *  @par Parameters
+ *    - @a emu = The emulator.
+ *    - @a cmd = The command byte.
+ */
+static void dog_emu_command(dog_emu_t *emu, uint8_t cmd)
+{
+  /* Second byte of a two-byte command */
+  if(emu->pending)
+  {
+    switch(emu->pending)
+    {
+    case 0x81: emu->contrast = cmd & 0x3F;         break;
+    case 0xF8: emu->booster = cmd & 0x03;          break;
+    default:   emu->static_indicator = (emu->pending & 1) ? (cmd & 0x03) : 0;
+               break;
+    }
+    emu->pending = 0;
+    return;
+  }
+
+  if(cmd >= 0x40 && cmd <= 0x7F)                  /* Display start line set */
+    emu->start_line = cmd & 0x3F;
+  else if((cmd & 0xF0) == 0xB0)                   /* Page address set */
+  {
+    if((cmd & 0x0F) < DOG_EMU_PAGES) emu->page = cmd & 0x0F;
+  }
+  else if((cmd & 0xF0) == 0x10)                   /* Column address, upper */
+    emu->column = (uint8_t)((cmd & 0x0F) << 4) | (emu->column & 0x0F);
+  else if((cmd & 0xF0) == 0x00)                   /* Column address, lower */
+    emu->column = (emu->column & 0xF0) | (cmd & 0x0F);
+  else if((cmd & 0xF8) == 0x20)                   /* Regulator ratio */
+    emu->regulator = cmd & 0x07;
+  else if((cmd & 0xF8) == 0x28)                   /* Power control */
+    emu->power = cmd & 0x07;
+  else if((cmd & 0xF0) == 0xC0)                   /* Common output mode */
+    emu->com_reverse = (cmd >> 3) & 1;
+  else
+  {
+    switch(cmd)
+    {
+    case 0xA0: case 0xA1: emu->adc_reverse = cmd & 1;  break;
+    case 0xA2: case 0xA3: emu->bias = cmd & 1;         break;
+    case 0xA4: case 0xA5: emu->all_on = cmd & 1;       break;
+    case 0xA6: case 0xA7: emu->inverted = cmd & 1;     break;
+    case 0xAE: case 0xAF: emu->display_on = cmd & 1;   break;
+    case 0xE0:                                         /* Read-modify-write */
+      emu->rmw = 1;
+      emu->rmw_column = emu->column;
+      break;
+    case 0xEE:                                         /* End */
+      if(emu->rmw) emu->column = emu->rmw_column;
+      emu->rmw = 0;
+      break;
+    case 0xE2:                                         /* Internal reset */
+      emu->start_line = 0;
+      emu->page = 0;
+      emu->column = 0;
+      emu->com_reverse = 0;
+      emu->regulator = 4;
+      emu->contrast = 0x20;
+      emu->rmw = 0;
+      break;
+    case 0x81: case 0xAC: case 0xAD: case 0xF8:        /* Two-byte commands */
+      emu->pending = cmd;
+      break;
+    default:                                           /* NOP and the rest */
+      break;
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+void dog_emu_init(dog_emu_t *emu)
+{
+  memset(emu, 0, sizeof(*emu));
+  dog_emu_hw_reset(emu);
+}
+
+void dog_emu_hw_reset(dog_emu_t *emu)
+{
+  emu->page = 0;
+  emu->column = 0;
+  emu->start_line = 0;
+  emu->adc_reverse = 0;
+  emu->com_reverse = 0;
+  emu->inverted = 0;
+  emu->all_on = 0;
+  emu->display_on = 0;
+  emu->power = 0;
+  emu->bias = 0;
+  emu->regulator = 4;
+  emu->contrast = 0x20;
+  emu->booster = 0;
+  emu->static_indicator = 0;
+  emu->rmw = 0;
+  emu->pending = 0;
+}
+
+void dog_emu_write(dog_emu_t *emu, uint8_t a0, const uint8_t *bytes,
+                   uint16_t count)
+{
+  for(; count; --count, ++bytes)
+  {
+    if(!a0)
+    {
+      emu->commands++;
+      dog_emu_command(emu, *bytes);
+      continue;
+    }
+
+    /* The column address stops at the last column */
+    emu->data++;
+    if(emu->column >= DOG_EMU_COLUMNS) continue;
+    emu->ram[emu->page][emu->column] = *bytes;
+    if(emu->column < DOG_EMU_COLUMNS - 1) emu->column++;
+  }
+}
+
+uint8_t dog_emu_pixel(const dog_emu_t *emu, uint8_t x, uint8_t y)
+{
+  uint8_t column, line, pixel;
+
+  if(!emu->display_on || emu->power != 0x07) return 0;
+  if(emu->all_on) return 1;
+
+  /* The glass spans SEG4 to SEG131, with SEG131 on the left */
+  column = emu->adc_reverse ? x : (DOG_EMU_COLUMNS - 1) - x;
+  line = ((emu->com_reverse ? (DOG_HEIGHT - 1) - y : y) + emu->start_line)
+         & (DOG_HEIGHT - 1);
+
+  pixel = (emu->ram[line >> 3][column] >> (line & 7)) & 1;
+  return pixel ^ emu->inverted;
+}
+
+void dog_emu_frame(const dog_emu_t *emu,
+                   uint8_t frame[DOG_PAGE_HEIGHT][DOG_WIDTH])
+{
+  uint8_t x, y;
+
+  memset(frame, 0, DOG_PAGE_HEIGHT * DOG_WIDTH);
+  for(y = 0; y < DOG_HEIGHT; ++y)
+    for(x = 0; x < DOG_WIDTH; ++x)
+      if(dog_emu_pixel(emu, x, y)) frame[y >> 3][x] |= 1 << (y & 7);
+}
+
+int8_t dog_emu_write_pbm(const dog_emu_t *emu, const char *path)
+{
+  FILE *file;
+  uint8_t x, y, bit, byte;
+  int8_t result = 0;
+
+  file = fopen(path, "wb");
+  if(!file) return -1;
+
+  /* P4: rows of packed bits, MSB first, 1 = black */
+  fprintf(file, "P4\n%d %d\n", DOG_WIDTH, DOG_HEIGHT);
+  for(y = 0; y < DOG_HEIGHT; ++y)
+  {
+    for(x = 0; x < DOG_WIDTH; x += 8)
+    {
+      byte = 0;
+      for(bit = 0; bit < 8; ++bit)
+        byte = (byte << 1) | dog_emu_pixel(emu, x + bit, y);
+      if(fputc(byte, file) == EOF) result = -1;
+    }
+  }
+
+  if(fclose(file) != 0) result = -1;
+  return result;
+}
+
+#if DOG_TRANSPORT == DOG_TRANSPORT_LINUX
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static dog_emu_t *attached
+ * @brief Emulator receiving the traffic of the Linux transport.
+ *
+ * @var static uint8_t reset_level
+ * @brief Last level of the reset line, to detect its falling edge.
+ */
+static dog_emu_t *attached = NULL;
+static uint8_t reset_level = 1;
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used in place of ioctl() while an emulator is attached.
+ *
+ *  @par Parameters
+ *    - @a fd      = The file descriptor.
+ *    - @a request = The ioctl request code.
+ *    - @a arg     = The argument of the request.
+ *
+ *  @returns 0, or the file descriptor of the line request.
+ */
+static int dog_emu_ioctl(int fd, unsigned long request, void *arg)
+{
+  const struct spi_ioc_transfer *xfer;
+  const struct gpio_v2_line_values *values;
+  uint16_t i, count;
+
+  if(request == GPIO_V2_GET_LINE_IOCTL)
+  {
+    /* Hand out a descriptor the transport may later close */
+    ((struct gpio_v2_line_request *)arg)->fd = dup(fd);
+    return 0;
+  }
+
+  if(request == GPIO_V2_LINE_SET_VALUES_IOCTL)
+  {
+    values = (const struct gpio_v2_line_values *)arg;
+    if(values->mask & 1) attached->a0 = values->bits & 1;
+    if(values->mask & 2)
+    {
+      if(reset_level && !(values->bits & 2)) dog_emu_hw_reset(attached);
+      reset_level = (values->bits >> 1) & 1;
+    }
+    return 0;
+  }
+
+  if(_IOC_TYPE(request) == SPI_IOC_MAGIC && _IOC_NR(request) == 0)
+  {
+    /* SPI_IOC_MESSAGE(n): the size encodes the number of transfers */
+    xfer = (const struct spi_ioc_transfer *)arg;
+    count = _IOC_SIZE(request) / sizeof(*xfer);
+    for(i = 0; i < count; ++i, ++xfer)
+      dog_emu_write(attached, attached->a0,
+                    (const uint8_t *)(unsigned long)xfer->tx_buf, xfer->len);
+    return 0;
+  }
+
+  return 0;                   /* Mode, word size and clock are accepted */
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+void dog_emu_attach(dog_emu_t *emu)
+{
+  static int (*saved)(int, unsigned long, void *) = NULL;
+
+  if(emu)
+  {
+    if(!attached) saved = dog_linux_ioctl;
+    attached = emu;
+    reset_level = 1;
+    dog_linux_ioctl = dog_emu_ioctl;
+  }
+  else if(attached)
+  {
+    attached = NULL;
+    dog_linux_ioctl = saved;
+  }
+}
+
+#endif /* DOG_TRANSPORT == DOG_TRANSPORT_LINUX */
+
+/* @} */ /* DOGM128_emulator_source */
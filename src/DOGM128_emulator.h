@@ -0,0 +1,176 @@
+/**
+ * @file   DOGM128_emulator.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Header file for an emulated ST7565R controller. <br>
+ * @defgroup DOGM128_emulator Controller Emulator
+ * @{
+ *
+ * This file contains function prototypes for a host-side model of the
+ * ST7565R controller of the DOG module. It interprets the same command and
+ * data bytes the library sends over SPI: display start line, ADC and common
+ * output direction, page and column addressing, read-modify-write, normal
+ * and inverse display, all points on, display on/off and the power, bias,
+ * booster, regulator, contrast and static indicator settings. The image the
+ * glass would show can then be read back pixel by pixel, compared against a
+ * buffer, or saved as a PBM file.
+ *
+ * With @b DOG_TRANSPORT_LINUX, dog_emu_attach() routes the transport's
+ * ioctls into an emulator, so the unmodified library can run on a plain
+ * Linux machine without any hardware.
+ *
+ * The image is rendered as seen with the module mounted for 6:00 viewing
+ * (ADC reverse, common output normal), which is how dog_init() sets it up.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_EMULATOR_H
+#define DOGM128_EMULATOR_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Columns of the display RAM of the ST7565R */
+#define DOG_EMU_COLUMNS 132
+/** Pages of the display RAM of the ST7565R, including the icon page */
+#define DOG_EMU_PAGES   9
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** used to hold the state of an emulated controller */
+typedef struct
+{
+  uint8_t ram[DOG_EMU_PAGES][DOG_EMU_COLUMNS]; /**< display data RAM        */
+  uint8_t page;               /**< page address                             */
+  uint8_t column;             /**< column address                           */
+  uint8_t start_line;         /**< display start line                       */
+  uint8_t adc_reverse;        /**< 1 after 0xA1                             */
+  uint8_t com_reverse;        /**< 1 after 0xC8                             */
+  uint8_t inverted;           /**< 1 after 0xA7                             */
+  uint8_t all_on;             /**< 1 after 0xA5                             */
+  uint8_t display_on;         /**< 1 after 0xAF                             */
+  uint8_t power;              /**< booster, regulator, follower bits        */
+  uint8_t bias;               /**< 0 for 1/9, 1 for 1/7                     */
+  uint8_t regulator;          /**< V5 voltage regulator ratio               */
+  uint8_t contrast;           /**< electronic volume                        */
+  uint8_t booster;            /**< booster ratio                            */
+  uint8_t static_indicator;   /**< static indicator mode, 0 when off        */
+  uint8_t rmw;                /**< 1 while in read-modify-write mode        */
+  uint8_t rmw_column;         /**< column restored by 0xEE                  */
+  uint8_t pending;            /**< command awaiting its second byte, or 0   */
+  uint8_t a0;                 /**< level of A0 (used by dog_emu_attach())   */
+  uint32_t commands;          /**< command bytes received                   */
+  uint32_t data;              /**< data bytes received                      */
+} dog_emu_t;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to power up an emulated controller.
+ *
+ *  @par Parameters
+ *         - @a emu = The emulator.
+ *
+ *  @par Algorithm
+ *       Clears the display RAM and performs a hardware reset.
+ */
+void dog_emu_init(dog_emu_t *emu);
+
+/** This function is used to pulse the reset pin of an emulated controller.
+ *
+ *  @par Parameters
+ *         - @a emu = The emulator.
+ *
+ *  @par Algorithm
+ *       Restores the power-on state of every register. Like the real
+ *       controller, the display RAM is left as it is.
+ */
+void dog_emu_hw_reset(dog_emu_t *emu);
+
+/** This function is used to feed bytes to an emulated controller, as if they
+ *  had been sent over SPI.
+ *
+ *  @par Parameters
+ *         - @a emu   = The emulator.
+ *         - @a a0    = The level of A0: 0 for commands, 1 for data.
+ *         - @a bytes = The bytes received.
+ *         - @a count = The number of bytes received.
+ *
+ *  @par Algorithm
+ *       Data bytes are stored at the page and column address, after which the
+ *       column address is incremented up to its last column. Command bytes
+ *       are decoded according to the ST7565R command table; unknown commands
+ *       are ignored, as are data bytes written to a column past the end.
+ */
+void dog_emu_write(dog_emu_t *emu, uint8_t a0, const uint8_t *bytes,
+                   uint16_t count);
+
+/** This function is used to find out what the glass shows at one pixel.
+ *
+ *  @par Parameters
+ *         - @a emu = The emulator.
+ *         - @a x   = The x-coordinate of the pixel [0,DOG_WIDTH-1].
+ *         - @a y   = The y-coordinate of the pixel [0,DOG_HEIGHT-1].
+ *
+ *  @par Algorithm
+ *       Maps @a x through the ADC direction onto a column address and @a y
+ *       through the common output direction and start line onto a RAM line.
+ *       The pixel is then modified by the all points on and inverse display
+ *       settings. Nothing is shown while the display is off or not fully
+ *       powered.
+ *
+ *  @returns 1 if the pixel is dark, 0 otherwise.
+ */
+uint8_t dog_emu_pixel(const dog_emu_t *emu, uint8_t x, uint8_t y);
+
+/** This function is used to capture the image shown by the glass in the
+ *  same page layout as @b dog_main_buffer, so that the two can be compared.
+ *
+ *  @par Parameters
+ *         - @a emu   = The emulator.
+ *         - @a frame = Receives the image.
+ */
+void dog_emu_frame(const dog_emu_t *emu,
+                   uint8_t frame[DOG_PAGE_HEIGHT][DOG_WIDTH]);
+
+/** This function is used to save the image shown by the glass as a binary
+ *  PBM (P4) file, which most image viewers and converters can read.
+ *
+ *  @par Parameters
+ *         - @a emu  = The emulator.
+ *         - @a path = The file to be written.
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise it
+ *           returns -1.
+ */
+int8_t dog_emu_write_pbm(const dog_emu_t *emu, const char *path);
+
+#if DOG_TRANSPORT == DOG_TRANSPORT_LINUX
+
+/** This function is used to connect the Linux transport to an emulator
+ *  instead of real devices.
+ *
+ *  @par Parameters
+ *         - @a emu = The emulator, or NULL to go back to the real ioctl().
+ *
+ *  @par Algorithm
+ *       Points @b dog_linux_ioctl at a handler which feeds every SPI message
+ *       to @a emu, tracks the A0 level set through the GPIO line request and
+ *       performs a hardware reset on a falling edge of the reset line. Any
+ *       files may be handed to dog_linux_open(), e.g. "/dev/null".
+ */
+void dog_emu_attach(dog_emu_t *emu);
+
+#endif /* DOG_TRANSPORT == DOG_TRANSPORT_LINUX */
+
+#endif /* DOGM128_EMULATOR_H */
+/** @} */ /* DOGM128_emulator */
@@ -0,0 +1,248 @@
+/*
+ * @file   DOGM128_frame.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for the frame scheduler of the EA DOGM128. <br>
+ * @defgroup DOGM128_frame_source
+ * @{
+ *
+ * This file contains the source code for the functions described in
+ * frame.h. The user should include this file, along with update.c, in his or
+ * her project should they choose to pace the display updates.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_frame.h"
+#include "DOGM128_update.h"
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static dog_dirty_t pending[2]
+ * @brief Regions waiting to be sent, by priority.
+ *
+ * @var static uint32_t since[DOG_PAGE_HEIGHT]
+ * @brief Time at which each page last went from nothing pending to pending.
+ *
+ * @var static uint8_t deferred[DOG_PAGE_HEIGHT]
+ * @brief Frames the low-priority region of each page has been held back.
+ *
+ * @var static uint8_t next_page
+ * @brief Page at which the next frame starts spending its budget.
+ *
+ * @var static uint32_t interval
+ * @brief Shortest time between two frames.
+ *
+ * @var static uint16_t budget
+ * @brief Data bytes per frame for low-priority regions.
+ *
+ * @var static uint32_t last_frame
+ * @brief Time at which the last frame was started.
+ *
+ * @var static uint8_t started
+ * @brief Set once the first frame has been sent.
+ *
+ * @var static dog_frame_stats_t stats
+ * @brief Statistics of the scheduler.
+ */
+static dog_dirty_t pending[2] = { DOG_DIRTY_CLEAN, DOG_DIRTY_CLEAN };
+static uint32_t since[DOG_PAGE_HEIGHT];
+static uint8_t deferred[DOG_PAGE_HEIGHT];
+static uint8_t next_page = 0;
+static uint32_t interval = DOG_FRAME_INTERVAL;
+static uint16_t budget = DOG_FRAME_BUDGET;
+static uint32_t last_frame = 0;
+static uint8_t started = 0;
+static dog_frame_stats_t stats;
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to check whether a page has a region pending.
+ *
+ *  @par Parameters
+ *    - @a page = The page.
+ *
+ *  @returns Non-zero if a region of either priority is pending.
+ */
+static uint8_t dog_frame_is_pending(uint8_t page)
+{
+  return pending[0].first[page] <= pending[0].last[page] ||
+         pending[1].first[page] <= pending[1].last[page];
+}
+
+/** This function is used to add a range of columns to the pending regions.
+ *
+ *  @par Parameters
+ *    - @a page     = The page.
+ *    - @a first    = First changed column.
+ *    - @a last     = Last changed column.
+ *    - @a priority = Priority of the change.
+ *    - @a now      = Current time.
+ */
+static void dog_frame_add(uint8_t page, uint8_t first, uint8_t last,
+                          uint8_t priority, uint32_t now)
+{
+  dog_dirty_t *region = &pending[priority ? 1 : 0];
+
+  if(!dog_frame_is_pending(page)) since[page] = now;
+  if(first < region->first[page]) region->first[page] = first;
+  if(last > region->last[page])   region->last[page] = last;
+}
+
+/** This function is used to move the pending region of a page into the
+ *  region to be sent.
+ *
+ *  @par Parameters
+ *    - @a send   = The region to be sent.
+ *    - @a region = The pending region to take the page from.
+ *    - @a page   = The page.
+ *
+ *  @returns The number of columns added to the region to be sent.
+ */
+static uint8_t dog_frame_take(dog_dirty_t *send, dog_dirty_t *region,
+                              uint8_t page)
+{
+  uint8_t before, first, last;
+
+  if(region->first[page] > region->last[page]) return 0;
+
+  before = (send->first[page] <= send->last[page]) ?
+           send->last[page] - send->first[page] + 1 : 0;
+  first = region->first[page];
+  last = region->last[page];
+  if(send->first[page] < first) first = send->first[page];
+  if(before && send->last[page] > last) last = send->last[page];
+  send->first[page] = first;
+  send->last[page] = last;
+
+  region->first[page] = DOG_WIDTH;                  /* No longer pending */
+  region->last[page] = 0;
+  return (last - first + 1) - before;
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+void dog_frame_configure(uint32_t frame_interval, uint16_t frame_budget)
+{
+  interval = frame_interval;
+  budget = frame_budget;
+}
+
+void dog_frame_invalidate(const dog_span_t *span, uint8_t priority)
+{
+  uint32_t now = DOG_GET_TICKS();
+  uint8_t page;
+
+  for(page = span->page_start; page <= span->page_end; ++page)
+    dog_frame_add(page, span->col_start, span->col_end, priority, now);
+  stats.invalidations++;
+}
+
+void dog_frame_submit(uint8_t priority)
+{
+  uint32_t now = DOG_GET_TICKS();
+  uint8_t page;
+
+  for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+  {
+    if(dog_main_dirty.first[page] > dog_main_dirty.last[page]) continue;
+    dog_frame_add(page, dog_main_dirty.first[page], dog_main_dirty.last[page],
+                  priority, now);
+  }
+  dog_dirty_reset(&dog_main_dirty);
+  stats.invalidations++;
+}
+
+int8_t dog_frame_poll(void)
+{
+  dog_dirty_t send = DOG_DIRTY_CLEAN;
+  uint32_t now = DOG_GET_TICKS();
+  uint32_t oldest = 0;
+  uint16_t spent = 0;
+  uint8_t page, i, width, any = 0;
+
+  for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+    any |= dog_frame_is_pending(page);
+  if(!any) return 0;
+  if(started && now - last_frame < interval) return 0;
+
+  /* Urgent changes first; they do not count against the budget */
+  for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+  {
+    dog_frame_take(&send, &pending[1], page);
+    if(deferred[page] >= DOG_FRAME_MAX_DEFER)
+      dog_frame_take(&send, &pending[0], page);
+  }
+
+  /* Then low-priority pages for as long as the budget lasts */
+  for(i = 0; i < DOG_PAGE_HEIGHT; ++i)
+  {
+    page = (next_page + i) & (DOG_PAGE_HEIGHT - 1);
+    if(pending[0].first[page] > pending[0].last[page]) continue;
+
+    width = pending[0].last[page] - pending[0].first[page] + 1;
+    if(spent + width <= budget)
+    {
+      spent += dog_frame_take(&send, &pending[0], page);
+    }
+    else
+    {
+      deferred[page]++;
+      stats.deferrals++;
+    }
+  }
+  next_page = (next_page + 1) & (DOG_PAGE_HEIGHT - 1);
+
+  any = 0;
+  for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+  {
+    if(send.first[page] <= send.last[page])
+    {
+      any = 1;
+      if(now - since[page] > oldest) oldest = now - since[page];
+    }
+    if(pending[0].first[page] > pending[0].last[page]) deferred[page] = 0;
+  }
+
+  /* Everything pending was held back; this is not a frame */
+  if(!any) return 0;
+
+  stats.last_bytes = dog_update_flush_region(&send);
+
+  if(started) stats.last_period = now - last_frame;
+  started = 1;
+  stats.frames++;
+  stats.last_duration = DOG_GET_TICKS() - now;
+  stats.last_latency = oldest + stats.last_duration;
+  if(stats.last_latency > stats.max_latency)
+    stats.max_latency = stats.last_latency;
+  last_frame = now;
+  return 1;
+}
+
+const dog_frame_stats_t *dog_frame_stats(void)
+{
+  return &stats;
+}
+
+void dog_frame_stats_reset(void)
+{
+  stats.frames = 0;
+  stats.invalidations = 0;
+  stats.deferrals = 0;
+  stats.last_bytes = 0;
+  stats.last_period = 0;
+  stats.last_duration = 0;
+  stats.last_latency = 0;
+  stats.max_latency = 0;
+}
+
+/* @} */ /* DOGM128_frame_source */
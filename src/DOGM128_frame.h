@@ -0,0 +1,126 @@
+/**
+ * @file   DOGM128_frame.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Header file for the frame scheduler of the EA DOGM128. <br>
+ * @defgroup DOGM128_frame Frame Scheduler
+ * @{
+ *
+ * This file contains function prototypes for a scheduler which decides when
+ * the main buffer is sent to the display. Instead of flushing after every
+ * change, the application hands the regions it changed to the scheduler and
+ * calls dog_frame_poll() from its main loop. Changes made between two frames
+ * are coalesced into one flush, frames are sent at most once every
+ * @b DOG_FRAME_INTERVAL ticks, and each frame spends at most
+ * @b DOG_FRAME_BUDGET data bytes on low-priority regions, so the time spent
+ * on the display per loop iteration stays bounded.
+ *
+ * High-priority regions are sent with the next frame. Low-priority regions
+ * which do not fit the budget wait for a later frame, but never for more
+ * than @b DOG_FRAME_MAX_DEFER frames.
+ *
+ * Frames are sent with dog_update_flush_region(), so only the bytes which
+ * differ from the display are transmitted.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_FRAME_H
+#define DOGM128_FRAME_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Priority of a region which may be deferred to stay within the budget */
+#define DOG_PRIORITY_LOW  0
+/** Priority of a region which is sent with the next frame */
+#define DOG_PRIORITY_HIGH 1
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** used to report the work and timing of the frame scheduler. Times are in
+ *  ticks of DOG_GET_TICKS().
+ */
+typedef struct
+{
+  uint32_t frames;          /**< frames sent                                 */
+  uint32_t invalidations;   /**< regions handed to the scheduler             */
+  uint32_t deferrals;       /**< pages held back for lack of budget          */
+  uint16_t last_bytes;      /**< data bytes sent by the last frame           */
+  uint32_t last_period;     /**< time between the last two frames            */
+  uint32_t last_duration;   /**< time spent sending the last frame           */
+  uint32_t last_latency;    /**< age of the oldest change the last frame sent*/
+  uint32_t max_latency;     /**< largest latency since the last reset        */
+} dog_frame_stats_t;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to change the pacing of the scheduler at run time.
+ *
+ *  @par Parameters
+ *         - @a frame_interval = Shortest time between two frames, in ticks.
+ *         - @a frame_budget   = Data bytes per frame for low-priority regions.
+ */
+void dog_frame_configure(uint32_t frame_interval, uint16_t frame_budget);
+
+/** This function is used to hand a changed region of @b dog_main_buffer to
+ *  the scheduler.
+ *
+ *  @par Parameters
+ *         - @a span     = The region that changed.
+ *         - @a priority = @b DOG_PRIORITY_HIGH or @b DOG_PRIORITY_LOW.
+ *
+ *  @par Assumptions
+ *       - @a span lies within the display.
+ */
+void dog_frame_invalidate(const dog_span_t *span, uint8_t priority);
+
+/** This function is used to hand everything drawn into @b dog_main_buffer
+ *  since the last call to the scheduler. The dirty region of the main buffer
+ *  is taken over and marked clean.
+ *
+ *  @par Parameters
+ *         - @a priority = @b DOG_PRIORITY_HIGH or @b DOG_PRIORITY_LOW.
+ */
+void dog_frame_submit(uint8_t priority);
+
+/** This function is used to send a frame if one is due.
+ *
+ *  @par Algorithm
+ *       Nothing is sent if no region is pending, or if less than the frame
+ *       interval has passed since the last frame. Otherwise the frame takes
+ *       the pending high-priority regions, the low-priority regions which
+ *       have waited @b DOG_FRAME_MAX_DEFER frames, and then as many other
+ *       low-priority pages as the budget allows, starting from a different
+ *       page each frame so that none is passed over for good. The cost of a
+ *       page is estimated as the width of its region.
+ *
+ *  @par Assumptions
+ *       - The user has called the dog_init() function.
+ *       - The orientation is one of the landscape modes.
+ *
+ *  @returns 1 if a frame was sent, 0 otherwise, including when every
+ *           pending region was held back for lack of budget.
+ */
+int8_t dog_frame_poll(void);
+
+/** This function is used to obtain the statistics of the scheduler.
+ *
+ *  @returns A pointer to the statistics.
+ */
+const dog_frame_stats_t *dog_frame_stats(void);
+
+/** This function is used to reset the statistics of the scheduler. */
+void dog_frame_stats_reset(void);
+
+#endif /* DOGM128_FRAME_H */
+/** @} */ /* DOGM128_frame */
@@ -0,0 +1,185 @@
+/*
+ * @file   DOGM128_gauge.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for needle gauges on the EA DOGM128. <br>
+ * @defgroup DOGM128_gauge_source
+ * @{
+ *
+ * This file contains the source code for the functions described in
+ * gauge.h. The user should include this file, along with arc.c and lines.c,
+ * in his or her project should they choose to use gauges.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_gauge.h"
+#include "DOGM128_arc.h"
+#include "DOGM128_lines.h"
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to work out a point on a circle around the pivot.
+ *
+ *  @par Parameters
+ *    - @a gauge  = The gauge.
+ *    - @a radius = Distance from the pivot.
+ *    - @a angle  = Angle in LCD_angles.
+ *    - @a x      = Receives the column of the point.
+ *    - @a y      = Receives the row of the point.
+ *
+ *  @returns 0 if the point lies on the display, -1 otherwise.
+ */
+static int8_t dog_gauge_point(const dog_gauge_t *gauge, uint8_t radius,
+                              uint8_t angle, uint8_t *x, uint8_t *y)
+{
+  int16_t px = gauge->x + (((int16_t)radius * dog_cos(angle)) >> 6);
+  int16_t py = gauge->y + (((int16_t)radius * dog_sin(angle)) >> 6);
+
+  if(px < 0 || px >= DOG_WIDTH || py < 0 || py >= DOG_HEIGHT) return -1;
+  *x = px;
+  *y = py;
+  return 0;
+}
+
+/** This function is used to invert the pixels of one needle position and
+ *  extend the rewritten region to include them.
+ *
+ *  @par Parameters
+ *    - @a gauge = The gauge.
+ *    - @a step  = The needle position.
+ *    - @a span  = Region rewritten so far; extended to cover the needle.
+ *
+ *  @par Algorithm
+ *       Bresenham's line algorithm from the pivot to the tip, inverting each
+ *       pixel in place.
+ *
+ *  @returns The number of pixels inverted.
+ */
+static uint16_t dog_gauge_needle(const dog_gauge_t *gauge, uint8_t step,
+                                 dog_span_t *span)
+{
+  uint8_t x = gauge->x, y = gauge->y;
+  uint8_t x2 = gauge->tip_x[step], y2 = gauge->tip_y[step];
+  int8_t sx = (x2 >= x) ? 1 : -1, sy = (y2 >= y) ? 1 : -1;
+  int16_t dx = (x2 >= x) ? x2 - x : x - x2;
+  int16_t dy = (y2 >= y) ? y2 - y : y - y2;
+  int16_t err = dx - dy, e2;
+  uint16_t count = 0;
+
+  for(;;)
+  {
+    dog_buffer[y >> 3][x] ^= 1 << (y & 7);
+    DOG_MARK_DIRTY(y >> 3, x);
+    ++count;
+    if(x == x2 && y == y2) break;
+
+    e2 = 2*err;
+    if(e2 > -dy)
+    {
+      err -= dy;
+      x += sx;
+    }
+    if(e2 < dx)
+    {
+      err += dx;
+      y += sy;
+    }
+  }
+
+  /* The needle lies within the box spanned by its two ends */
+  if(x2 < span->col_start) span->col_start = x2;
+  if(x2 > span->col_end)   span->col_end = x2;
+  if((y2 >> 3) < span->page_start) span->page_start = y2 >> 3;
+  if((y2 >> 3) > span->page_end)   span->page_end = y2 >> 3;
+
+  DOG_STAT_ADD(pixels, count);
+  DOG_STAT_ADD(buffer_bytes, count);
+  return count;
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int8_t dog_gauge_init(dog_gauge_t *gauge,
+                      uint8_t x,
+                      uint8_t y,
+                      uint8_t radius,
+                      uint8_t start_angle,
+                      uint8_t sweep,
+                      uint16_t max)
+{
+  uint8_t i, angle;
+
+  if(x >= DOG_WIDTH || y >= DOG_HEIGHT || sweep == 0 || max == 0) return -1;
+
+  gauge->x = x;
+  gauge->y = y;
+  gauge->radius = radius;
+  gauge->start_angle = start_angle;
+  gauge->sweep = sweep;
+  gauge->max = max;
+  gauge->steps = (sweep < DOG_GAUGE_STEPS) ? sweep + 1 : DOG_GAUGE_STEPS;
+
+  for(i = 0; i < gauge->steps; ++i)
+  {
+    angle = start_angle + (uint16_t)sweep * i / (gauge->steps - 1);
+    if(dog_gauge_point(gauge, radius, angle,
+                       &gauge->tip_x[i], &gauge->tip_y[i]) < 0) return -1;
+  }
+
+  dog_gauge_invalidate(gauge);
+  return 0;
+}
+
+void dog_gauge_draw_dial(const dog_gauge_t *gauge, uint8_t ticks)
+{
+  uint8_t i, angle, x1, y1, x2, y2;
+
+  dog_draw_arc(gauge->x, gauge->y, gauge->radius + 2, gauge->start_angle,
+               gauge->start_angle + gauge->sweep, 0, 's');
+
+  for(i = 0; ticks > 1 && i < ticks; ++i)
+  {
+    angle = gauge->start_angle + (uint16_t)gauge->sweep * i / (ticks - 1);
+    if(dog_gauge_point(gauge, gauge->radius + 2, angle, &x1, &y1) < 0 ||
+       dog_gauge_point(gauge, gauge->radius + 4, angle, &x2, &y2) < 0)
+      continue;
+    dog_draw_line(x1, y1, x2, y2, 0, 's');
+  }
+}
+
+uint16_t dog_gauge_update(dog_gauge_t *gauge, uint16_t value, dog_span_t *span)
+{
+  dog_span_t region;
+  uint16_t count = 0;
+  uint8_t step;
+
+  if(value > gauge->max) value = gauge->max;
+  step = (uint32_t)value * (gauge->steps - 1) / gauge->max;
+  if(step == gauge->shown) return 0;
+
+  region.page_start = region.page_end = gauge->y >> 3;
+  region.col_start = region.col_end = gauge->x;
+
+  /* Inverting the old needle again restores the dial */
+  if(gauge->shown != DOG_GAUGE_NONE)
+    count += dog_gauge_needle(gauge, gauge->shown, &region);
+  count += dog_gauge_needle(gauge, step, &region);
+  gauge->shown = step;
+
+  if(span) *span = region;
+  return count;
+}
+
+void dog_gauge_invalidate(dog_gauge_t *gauge)
+{
+  gauge->shown = DOG_GAUGE_NONE;
+}
+
+/* @} */ /* DOGM128_gauge_source */
@@ -0,0 +1,138 @@
+/**
+ * @file   DOGM128_gauge.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Header file for needle gauges on the EA DOGM128. <br>
+ * @defgroup DOGM128_gauge Needle Gauges
+ * @{
+ *
+ * This file contains function prototypes for analog gauges: a dial drawn
+ * once, and a needle which is drawn over it by inverting pixels. Inverting
+ * the same needle again restores the dial underneath, so moving the needle
+ * costs the pixels of the old and the new needle only; the dial is never
+ * redrawn.
+ *
+ * The tip of every needle position is worked out from the sine table when
+ * the gauge is set up, so an update only has to rasterize two lines.
+ *
+ * Angles are given in LCD_angles as for dog_draw_arc(): 0 points right, 64
+ * down, 128 left and 192 up, so a gauge sweeping over the top from left to
+ * right starts at 128 with a sweep of 128.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_GAUGE_H
+#define DOGM128_GAUGE_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Value of the @a shown member while no needle is drawn */
+#define DOG_GAUGE_NONE  0xFF
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** used to store the geometry and state of a gauge */
+typedef struct
+{
+  uint8_t x;                        /**< column of the needle pivot        */
+  uint8_t y;                        /**< row of the needle pivot           */
+  uint8_t radius;                   /**< length of the needle              */
+  uint8_t start_angle;              /**< angle of the needle at zero       */
+  uint8_t sweep;                    /**< angle from zero to full scale     */
+  uint8_t steps;                    /**< needle positions in use           */
+  uint16_t max;                     /**< value at full scale               */
+  uint8_t shown;                    /**< position drawn, or DOG_GAUGE_NONE */
+  uint8_t tip_x[DOG_GAUGE_STEPS];   /**< column of the tip per position    */
+  uint8_t tip_y[DOG_GAUGE_STEPS];   /**< row of the tip per position       */
+} dog_gauge_t;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to set up a gauge and work out its needle
+ *  positions. Nothing is drawn.
+ *
+ *  @par Parameters
+ *         - @a gauge       = The gauge to be set up.
+ *         - @a x           = Column of the needle pivot [0,127].
+ *         - @a y           = Row of the needle pivot [0,63].
+ *         - @a radius      = Length of the needle in pixels.
+ *         - @a start_angle = Angle of the needle at zero, in LCD_angles.
+ *         - @a sweep       = Angle from zero to full scale, in LCD_angles
+ *                            [1,255]; the needle turns clockwise.
+ *         - @a max         = Value at full scale [1,65535].
+ *
+ *  @par Algorithm
+ *       The sweep is divided into up to @b DOG_GAUGE_STEPS positions, one
+ *       per LCD_angle at most. The tip of each is found with dog_cos() and
+ *       dog_sin() and stored in the gauge.
+ *
+ *  @returns Upon successful completion, the function returns zero. It returns
+ *           -1 if any needle position leaves the display.
+ */
+int8_t dog_gauge_init(dog_gauge_t *gauge,
+                      uint8_t x,
+                      uint8_t y,
+                      uint8_t radius,
+                      uint8_t start_angle,
+                      uint8_t sweep,
+                      uint16_t max);
+
+/** This function is used to draw the dial of a gauge: an arc just outside
+ *  the reach of the needle, with tick marks. It should be drawn once, before
+ *  the needle, and again only after the area was drawn over.
+ *
+ *  @par Parameters
+ *         - @a gauge = The gauge.
+ *         - @a ticks = Number of tick marks, spread evenly over the sweep
+ *                      from zero to full scale; 0 or 1 for none.
+ *
+ *  @par Assumptions
+ *       - The arc, radius + 2 from the pivot, and ticks reaching out to
+ *         radius + 4, fit on the display.
+ *       - The needle is not drawn. Otherwise, call dog_gauge_invalidate()
+ *         after clearing the area.
+ */
+void dog_gauge_draw_dial(const dog_gauge_t *gauge, uint8_t ticks);
+
+/** This function is used to move the needle of a gauge to a new value.
+ *
+ *  @par Parameters
+ *         - @a gauge = The gauge to be updated.
+ *         - @a value = The new value [0,max]; larger values show full scale.
+ *         - @a span  = Optional (may be NULL). Receives the region of the
+ *                      buffer that was rewritten.
+ *
+ *  @par Algorithm
+ *       If the value maps to a different position, the old needle is
+ *       inverted again, which erases it, and the new one is inverted in.
+ *       Each needle is a line from the pivot to its stored tip.
+ *
+ *  @par Assumptions
+ *       - Nothing else draws over the needle. If it does, redraw the dial
+ *         and call dog_gauge_invalidate().
+ *       - The orientation is one of the landscape modes.
+ *
+ *  @returns The number of pixels inverted. @a span is only written when this
+ *           is non-zero.
+ */
+uint16_t dog_gauge_update(dog_gauge_t *gauge, uint16_t value, dog_span_t *span);
+
+/** This function is used to tell a gauge that its needle is no longer on
+ *  the screen, e.g. after the area was cleared. The next call to
+ *  dog_gauge_update() draws the needle without erasing first.
+ */
+void dog_gauge_invalidate(dog_gauge_t *gauge);
+
+#endif /* DOGM128_GAUGE_H */
+/** @} */ /* DOGM128_gauge */
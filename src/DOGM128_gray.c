@@ -0,0 +1,198 @@
+/*
+ * @file   DOGM128_gray.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for 4-level grayscale on the EA DOGM128. <br>
+ * @defgroup DOGM128_gray_source
+ * @{
+ *
+ * This file contains the source code for the functions described in
+ * gray.h. The user should include this file, along with update.c, in his or
+ * her project should they choose to use grayscale. Note that it holds 2 KB
+ * of bitplanes.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_gray.h"
+#include "DOGM128_update.h"
+
+/*----------------------------------------------------------------------------*/
+/* GLOBAL DATA                                                                */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var uint8_t dog_gray_planes[2][DOG_PAGE_HEIGHT][DOG_WIDTH]
+ * @brief Low and high bitplane of the grayscale image.
+ */
+uint8_t dog_gray_planes[2][DOG_PAGE_HEIGHT][DOG_WIDTH];
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static dog_dirty_t drawn
+ * @brief Columns of each page drawn into since the last tick.
+ *
+ * @var static dog_dirty_t gray
+ * @brief Columns of each page which hold gray pixels.
+ *
+ * @var static uint8_t frame
+ * @brief Frame to be shown by the next tick [0,DOG_GRAY_FRAMES-1].
+ */
+static dog_dirty_t drawn = DOG_DIRTY_CLEAN;
+static dog_dirty_t gray = DOG_DIRTY_CLEAN;
+static uint8_t frame = 0;
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to set the rows selected by a mask in a range of
+ *  columns of one page to a gray level.
+ *
+ *  @par Parameters
+ *    - @a page  = The page.
+ *    - @a x1    = First column.
+ *    - @a x2    = Last column.
+ *    - @a mask  = The rows of the page to be changed.
+ *    - @a level = Gray level [0,3].
+ */
+static void dog_gray_apply(uint8_t page, uint8_t x1, uint8_t x2,
+                           uint8_t mask, uint8_t level)
+{
+  uint8_t *lo = &dog_gray_planes[0][page][x1];
+  uint8_t *hi = &dog_gray_planes[1][page][x1];
+  uint8_t lo_bits = (level & 1) ? mask : 0;
+  uint8_t hi_bits = (level & 2) ? mask : 0;
+  uint8_t n;
+
+  for(n = x2 - x1 + 1; n; --n)
+  {
+    *lo = (*lo & ~mask) | lo_bits;
+    *hi = (*hi & ~mask) | hi_bits;
+    ++lo;
+    ++hi;
+  }
+
+  if(x1 < drawn.first[page]) drawn.first[page] = x1;
+  if(x2 > drawn.last[page])  drawn.last[page] = x2;
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int8_t dog_gray_pixel(uint8_t x, uint8_t y, uint8_t level)
+{
+  if(x >= DOG_WIDTH || y >= DOG_HEIGHT || level >= DOG_GRAY_LEVELS) return -1;
+
+  dog_gray_apply(y >> 3, x, x, 1 << (y & 7), level);
+  DOG_STAT_ADD(pixels, 1);
+  return 0;
+}
+
+int8_t dog_gray_fill_rectangle(uint8_t x, uint8_t y, uint8_t width,
+                               uint8_t height, uint8_t level)
+{
+  uint8_t x2, y2, page, mask, top, bottom;
+
+  if(x >= DOG_WIDTH || y >= DOG_HEIGHT || !width || !height) return -1;
+  if(level >= DOG_GRAY_LEVELS) return -1;
+
+  x2 = (width > DOG_WIDTH - x) ? DOG_WIDTH - 1 : x + width - 1;
+  y2 = (height > DOG_HEIGHT - y) ? DOG_HEIGHT - 1 : y + height - 1;
+
+  for(page = y >> 3; page <= (y2 >> 3); ++page)
+  {
+    /* Rows of the rectangle within this page */
+    top = (page == (y >> 3)) ? (y & 7) : 0;
+    bottom = (page == (y2 >> 3)) ? (y2 & 7) : 7;
+    mask = (uint8_t)(0xFF << top) & (uint8_t)(0xFF >> (7 - bottom));
+
+    dog_gray_apply(page, x, x2, mask, level);
+  }
+  return 0;
+}
+
+void dog_gray_clear(void)
+{
+  uint8_t *lo = dog_gray_planes[0][0];
+  uint8_t *hi = dog_gray_planes[1][0];
+  uint16_t n;
+
+  for(n = DOG_PAGE_HEIGHT * DOG_WIDTH; n; --n)
+  {
+    *lo++ = 0;
+    *hi++ = 0;
+  }
+  dog_dirty_set_all(&drawn);
+}
+
+uint16_t dog_gray_tick(void)
+{
+  const uint8_t *lo, *hi;
+  uint8_t *dst;
+  uint8_t page, col, first, last;
+  uint16_t bytes;
+
+  for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+  {
+    lo = dog_gray_planes[0][page];
+    hi = dog_gray_planes[1][page];
+
+    /* Find the gray pixels again only where they may have changed */
+    if(drawn.first[page] <= drawn.last[page])
+    {
+      first = 0;
+      while(first < DOG_WIDTH && !(lo[first] ^ hi[first])) ++first;
+      last = DOG_WIDTH - 1;
+      while(last > first && !(lo[last] ^ hi[last])) --last;
+      if(first < DOG_WIDTH)
+      {
+        gray.first[page] = first;
+        gray.last[page] = last;
+      }
+      else
+      {
+        gray.first[page] = DOG_WIDTH - 1;           /* No gray pixels */
+        gray.last[page] = 0;
+      }
+    }
+
+    /* Columns whose frame differs from the previous one, or was redrawn */
+    first = gray.first[page];
+    last = gray.last[page];
+    if(drawn.first[page] < first) first = drawn.first[page];
+    if(drawn.last[page] > last)   last = drawn.last[page];
+    if(first > last) continue;
+
+    dst = dog_main_buffer[page];
+    switch(frame)
+    {
+    case 0:
+      for(col = first; col <= last; ++col) dst[col] = lo[col] | hi[col];
+      break;
+    case 1:
+      for(col = first; col <= last; ++col) dst[col] = hi[col];
+      break;
+    default:
+      for(col = first; col <= last; ++col) dst[col] = lo[col] & hi[col];
+      break;
+    }
+
+    if(first < dog_main_dirty.first[page]) dog_main_dirty.first[page] = first;
+    if(last > dog_main_dirty.last[page])   dog_main_dirty.last[page] = last;
+  }
+
+  dog_dirty_reset(&drawn);
+  if(++frame == DOG_GRAY_FRAMES) frame = 0;
+
+  /* Only the rebuilt columns can differ from what the display shows */
+  bytes = dog_update_flush_region(&dog_main_dirty);
+  dog_dirty_reset(&dog_main_dirty);
+  return bytes;
+}
+
+/* @} */ /* DOGM128_gray_source */
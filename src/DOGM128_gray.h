@@ -0,0 +1,113 @@
+/**
+ * @file   DOGM128_gray.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Header file for 4-level grayscale on the EA DOGM128. <br>
+ * @defgroup DOGM128_gray Grayscale
+ * @{
+ *
+ * This file contains function prototypes for drawing with four gray levels
+ * on the 1-bit display by frame rate control: the image is held in two
+ * bitplanes, and every call to dog_gray_tick() shows the next of three
+ * 1-bit frames. A pixel of level @a g is dark in @a g of the three frames,
+ * so level 0 is white, 1 and 2 are light and dark gray, and 3 is black.
+ *
+ * Only gray pixels differ between frames. dog_gray_tick() therefore rebuilds
+ * only the columns of each page which hold gray pixels (or which were drawn
+ * into since the last tick) and sends only those columns with
+ * dog_update_flush_region(), which transmits just the bytes that changed.
+ * Pages without gray pixels cost nothing once they have been sent.
+ *
+ * For a steady image, dog_gray_tick() should be called at a fixed rate of at
+ * least 150 Hz, e.g. from a timer. The grayscale image replaces the contents
+ * of @b dog_main_buffer.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_GRAY_H
+#define DOGM128_GRAY_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Number of gray levels, including white and black */
+#define DOG_GRAY_LEVELS 4
+/** Number of 1-bit frames in one cycle */
+#define DOG_GRAY_FRAMES (DOG_GRAY_LEVELS - 1)
+
+/*----------------------------------------------------------------------------*/
+/* EXTERNAL DATA                                                              */
+/*----------------------------------------------------------------------------*/
+/** Bitplanes of the grayscale image, in the page layout of the main buffer:
+ *  plane 0 holds the low bit and plane 1 the high bit of each level.
+ */
+extern uint8_t dog_gray_planes[2][DOG_PAGE_HEIGHT][DOG_WIDTH];
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to set the gray level of a pixel.
+ *
+ *  @par Parameters
+ *         - @a x     = X coordinate of the pixel [0,127].
+ *         - @a y     = Y coordinate of the pixel [0,63].
+ *         - @a level = Gray level [0,3]; 0 is white.
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise it
+ *           returns -1.
+ */
+int8_t dog_gray_pixel(uint8_t x, uint8_t y, uint8_t level);
+
+/** This function is used to fill a rectangle with a gray level.
+ *
+ *  @par Parameters
+ *         - @a x      = X coordinate of the top-left corner [0,127].
+ *         - @a y      = Y coordinate of the top-left corner [0,63].
+ *         - @a width  = Width of the rectangle in pixels; clipped at the edge.
+ *         - @a height = Height of the rectangle in pixels; clipped at the edge.
+ *         - @a level  = Gray level [0,3]; 0 is white.
+ *
+ *  @par Algorithm
+ *       Works a page at a time: the rows of the rectangle within a page form
+ *       a mask, which is applied to each column of both planes.
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise it
+ *           returns -1.
+ */
+int8_t dog_gray_fill_rectangle(uint8_t x, uint8_t y, uint8_t width,
+                               uint8_t height, uint8_t level);
+
+/** This function is used to set every pixel of the grayscale image to white.
+ */
+void dog_gray_clear(void);
+
+/** This function is used to show the next frame of the grayscale image.
+ *
+ *  @par Algorithm
+ *       For each page, the extent of its gray pixels is updated if the page
+ *       was drawn into. Over that extent and the area drawn into, the frame
+ *       is built into @b dog_main_buffer from the planes (frame 0: either
+ *       bit set, frame 1: high bit set, frame 2: both bits set). The columns
+ *       rebuilt, and any others marked in @b dog_main_dirty, are then sent
+ *       with dog_update_flush_region() and the dirty region is reset; the
+ *       rest of the buffer is not compared with the shadow copy.
+ *
+ *  @par Assumptions
+ *       - The user has called the dog_init() function.
+ *       - The orientation is one of the landscape modes.
+ *       - After dog_update_invalidate(), the whole buffer has been marked
+ *         dirty (e.g. by dog_gray_clear()) so that it is sent again.
+ *
+ *  @returns The number of data bytes sent to the display.
+ */
+uint16_t dog_gray_tick(void);
+
+#endif /* DOGM128_GRAY_H */
+/** @} */ /* DOGM128_gray */
@@ -0,0 +1,242 @@
+/*
+ * @file   DOGM128_layer.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for compositing several off-screen layers on the
+ *         EA DOGM128. <br>
+ * @defgroup DOGM128_layer_source
+ * @{
+ *
+ * This file contains the source code for the functions described in
+ * layer.h. The user should include this file in his or her project
+ * should they choose to use more than one layer. It holds the buffers of
+ * layers 1 and up; layer 0 is the main buffer found in common.c.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_layer.h"
+
+#if DOG_LAYER_COUNT < 2
+#error "DOG_LAYER_COUNT must be at least 2 when DOGM128_layer.c is used"
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** used to hold the state of a single layer */
+typedef struct
+{
+  uint8_t (*buffer)[DOG_WIDTH];   /* contents of the layer                   */
+  dog_dirty_t *dirty;             /* changed since the last flush            */
+  dog_dirty_t extent;             /* drawn into since the layer was cleared  */
+  dog_blend_t blend;              /* how the layer is merged                 */
+  uint8_t visible;                /* 0 when hidden                           */
+} dog_layer_t;
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static uint8_t layer_buffers[][DOG_PAGE_HEIGHT][DOG_WIDTH]
+ * @brief Buffers of layers 1 and up.
+ *
+ * @var static dog_dirty_t layer_dirty[]
+ * @brief Dirty regions of layers 1 and up.
+ *
+ * @var static dog_dirty_t pending
+ * @brief Areas which need resending although no layer drew into them, e.g.
+ *        because a layer was hidden.
+ *
+ * @var static dog_layer_t layers[]
+ * @brief State of every layer, including the main buffer.
+ *
+ * @var static uint8_t initialized
+ * @brief Set once layers[] has been filled in.
+ */
+static uint8_t layer_buffers[DOG_LAYER_COUNT - 1][DOG_PAGE_HEIGHT][DOG_WIDTH];
+static dog_dirty_t layer_dirty[DOG_LAYER_COUNT - 1];
+static dog_dirty_t pending = DOG_DIRTY_CLEAN;
+static dog_layer_t layers[DOG_LAYER_COUNT];
+static uint8_t initialized = 0;
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to set up the layer table the first time any layer
+ *  function is called.
+ */
+static void dog_layer_setup(void)
+{
+  uint8_t i;
+
+  layers[0].buffer = dog_main_buffer;
+  layers[0].dirty = &dog_main_dirty;
+  for(i = 1; i < DOG_LAYER_COUNT; ++i)
+  {
+    layers[i].buffer = layer_buffers[i - 1];
+    layers[i].dirty = &layer_dirty[i - 1];
+    dog_dirty_reset(layers[i].dirty);
+  }
+  for(i = 0; i < DOG_LAYER_COUNT; ++i)
+  {
+    dog_dirty_reset(&layers[i].extent);
+    layers[i].blend = DOG_BLEND_OR;
+    layers[i].visible = 1;
+  }
+  initialized = 1;
+}
+
+/** This function is used to add one dirty region to another.
+ *
+ *  @par Parameters
+ *    - @a to   = The dirty region to be extended.
+ *    - @a from = The dirty region to be added.
+ */
+static void dog_dirty_merge(dog_dirty_t *to, const dog_dirty_t *from)
+{
+  uint8_t page;
+
+  for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+  {
+    if(from->first[page] < to->first[page]) to->first[page] = from->first[page];
+    if(from->last[page] > to->last[page])   to->last[page] = from->last[page];
+  }
+}
+
+/** This function is used to fill every byte of a layer with a value.
+ *
+ *  @par Parameters
+ *    - @a layer = The layer to be filled.
+ *    - @a value = The value each byte is set to.
+ */
+static void dog_layer_fill(dog_layer_t *layer, uint8_t value)
+{
+  uint8_t *p = layer->buffer[0];
+  uint16_t n;
+
+  for(n = DOG_PAGE_HEIGHT * DOG_WIDTH; n; --n) *p++ = value;
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int8_t dog_layer_select(uint8_t layer)
+{
+  if(layer >= DOG_LAYER_COUNT) return -1;
+  if(!initialized) dog_layer_setup();
+
+  dog_set_draw_target(layers[layer].buffer, layers[layer].dirty);
+  return 0;
+}
+
+int8_t dog_layer_set_blend(uint8_t layer, dog_blend_t blend)
+{
+  if(layer == 0 || layer >= DOG_LAYER_COUNT) return -1;
+  if(!initialized) dog_layer_setup();
+
+  if(blend == layers[layer].blend) return 0;
+
+  /* An AND layer is transparent when full, the others when empty */
+  dog_layer_fill(&layers[layer], (blend == DOG_BLEND_AND) ? 0xFF : 0x00);
+  layers[layer].blend = blend;
+  dog_dirty_set_all(&layers[layer].extent);
+  dog_dirty_set_all(&pending);
+  return 0;
+}
+
+int8_t dog_layer_show(uint8_t layer, uint8_t visible)
+{
+  if(layer == 0 || layer >= DOG_LAYER_COUNT) return -1;
+  if(!initialized) dog_layer_setup();
+
+  visible = visible ? 1 : 0;
+  if(visible == layers[layer].visible) return 0;
+
+  /* Only the area the layer has drawn into changes appearance */
+  layers[layer].visible = visible;
+  dog_dirty_merge(&pending, &layers[layer].extent);
+  dog_dirty_merge(&pending, layers[layer].dirty);
+  return 0;
+}
+
+int8_t dog_layer_clear(uint8_t layer)
+{
+  if(layer >= DOG_LAYER_COUNT) return -1;
+  if(!initialized) dog_layer_setup();
+
+  dog_dirty_merge(&pending, &layers[layer].extent);
+  dog_dirty_merge(&pending, layers[layer].dirty);
+  dog_dirty_reset(&layers[layer].extent);
+  dog_dirty_reset(layers[layer].dirty);
+  dog_layer_fill(&layers[layer],
+                 (layers[layer].blend == DOG_BLEND_AND) ? 0xFF : 0x00);
+  return 0;
+}
+
+void dog_layer_flush(void)
+{
+  const uint8_t *sources[DOG_LAYER_COUNT];
+  dog_blend_t modes[DOG_LAYER_COUNT];
+  uint8_t page, col, first, last, i, n, byte;
+
+  if(!initialized) dog_layer_setup();
+  DOG_STAT_FLUSH_BEGIN();
+
+  /* Combine the dirty regions of all layers; remember what each one covered */
+  for(i = 0; i < DOG_LAYER_COUNT; ++i)
+  {
+    dog_dirty_merge(&pending, layers[i].dirty);
+    dog_dirty_merge(&layers[i].extent, layers[i].dirty);
+    dog_dirty_reset(layers[i].dirty);
+  }
+
+  DOG_SLAVE_SELECT();
+
+  for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+  {
+    first = pending.first[page];
+    last = pending.last[page];
+    if(first > last) continue;                        /* Page is clean */
+
+    /* Gather the visible layers of this page once */
+    n = 0;
+    for(i = 0; i < DOG_LAYER_COUNT; ++i)
+    {
+      if(i && !layers[i].visible) continue;
+      sources[n] = layers[i].buffer[page];
+      modes[n] = layers[i].blend;
+      ++n;
+    }
+
+    dog_set_address(page, first);
+    DOG_SEND_DATA();                    /* A0 stays high for the whole run */
+
+    for(col = first; col <= last; ++col)
+    {
+      byte = sources[0][col];
+      for(i = 1; i < n; ++i)
+      {
+        switch(modes[i])
+        {
+        case DOG_BLEND_AND: byte &= sources[i][col]; break;
+        case DOG_BLEND_XOR: byte ^= sources[i][col]; break;
+        default:            byte |= sources[i][col]; break;
+        }
+      }
+      DOG_SPI_TRANSMIT(byte);
+    }
+  }
+
+  DOG_SLAVE_DESELECT();
+
+  dog_dirty_reset(&pending);
+  DOG_STAT_FLUSH_END();
+}
+
+/* @} */ /* DOGM128_layer_source */
@@ -0,0 +1,137 @@
+/**
+ * @file   DOGM128_layer.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Header file for compositing several off-screen layers on the
+ *         EA DOGM128. <br>
+ * @defgroup DOGM128_layer Layers
+ * @{
+ *
+ * This file contains function prototypes for drawing into several
+ * independent buffers (layers) which are merged while they are sent to the
+ * display. Layer 0 is the main buffer; the remaining layers are typically
+ * used for dynamic content and overlays such as a blinking cursor. Each
+ * layer keeps its own dirty region, so a static background drawn once into
+ * layer 0 never has to be redrawn when the layers above it change.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_LAYER_H
+#define DOGM128_LAYER_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** used to select how a layer is merged with the layers below it */
+typedef enum{DOG_BLEND_OR = 0, DOG_BLEND_AND, DOG_BLEND_XOR} dog_blend_t;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to select the layer that all drawing functions
+ *  write to.
+ *
+ *  @par Parameters
+ *         - @a layer = The layer to draw into [0,DOG_LAYER_COUNT-1]. Layer 0
+ *                      is the main buffer.
+ *
+ *  @par Algorithm
+ *       Points the draw target at the layer's buffer and dirty region.
+ *
+ *  @par Assumptions
+ *       - None
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise it
+ *           returns -1.
+ */
+int8_t dog_layer_select(uint8_t layer);
+
+/** This function is used to set how a layer is merged with the layers below
+ *  it. Layers are merged in order, starting from layer 0. The blend mode of
+ *  layer 0 is ignored.
+ *
+ *  @par Parameters
+ *         - @a layer = The layer to be changed [1,DOG_LAYER_COUNT-1].
+ *         - @a blend = @b DOG_BLEND_OR sets pixels which are set in the layer,
+ *                      @b DOG_BLEND_AND clears pixels which are clear in the
+ *                      layer and @b DOG_BLEND_XOR inverts pixels which are set
+ *                      in the layer.
+ *
+ *  @par Algorithm
+ *       Stores the new blend mode and marks the layer's contents dirty.
+ *       Switching to @b DOG_BLEND_AND sets every pixel of the layer, so that
+ *       the layer starts out transparent; switching away from it clears the
+ *       layer.
+ *
+ *  @par Assumptions
+ *       - None
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise it
+ *           returns -1.
+ */
+int8_t dog_layer_set_blend(uint8_t layer, dog_blend_t blend);
+
+/** This function is used to show or hide a layer without touching its
+ *  contents; useful for blinking overlays.
+ *
+ *  @par Parameters
+ *         - @a layer   = The layer to be shown or hidden
+ *                        [1,DOG_LAYER_COUNT-1].
+ *         - @a visible = 1 to show the layer, 0 to hide it.
+ *
+ *  @par Algorithm
+ *       Stores the visibility and marks the area the layer has drawn into
+ *       since it was last cleared as dirty, so that only that area is resent
+ *       by the next dog_layer_flush().
+ *
+ *  @par Assumptions
+ *       - None
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise it
+ *           returns -1.
+ */
+int8_t dog_layer_show(uint8_t layer, uint8_t visible);
+
+/** This function is used to erase the contents of a layer.
+ *
+ *  @par Parameters
+ *         - @a layer = The layer to be erased [0,DOG_LAYER_COUNT-1].
+ *
+ *  @par Algorithm
+ *       Marks the area the layer has drawn into as dirty, then clears the
+ *       layer (or sets it, for a @b DOG_BLEND_AND layer).
+ *
+ *  @par Assumptions
+ *       - None
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise it
+ *           returns -1.
+ */
+int8_t dog_layer_clear(uint8_t layer);
+
+/** This function is used to send the merged layers to the display.
+ *
+ *  @par Algorithm
+ *       For each page, the dirty regions of all layers are combined into a
+ *       single column range. The page and column address are set once, then
+ *       each byte of the range is computed by merging the layers in order
+ *       and sent straight to the display; the merged image is never stored.
+ *       Afterwards, every layer is marked clean.
+ *
+ *  @par Assumptions
+ *       - The user has called the dog_init() function.
+ *       - Drawing goes through the library's drawing functions, or
+ *         dog_invalidate() is called for direct buffer writes.
+ */
+void dog_layer_flush(void);
+
+#endif /* DOGM128_LAYER_H */
+/** @} */ /* DOGM128_layer */
@@ -38,7 +38,7 @@ void dog_draw_line(uint8_t x1,
   int8_t ystep;
   
   /* Ensure parameters are properly set */
-  if(x1 >= DOG_WIDTH || x2 >= DOG_WIDTH || y1 >= DOG_HEIGHT || y2 >= DOG_HEIGHT) return;
+  if(x1 >= dog_width || x2 >= dog_width || y1 >= dog_height || y2 >= dog_height) return;
   if (mode != 'c' && mode != 's') return;
   if (size > 1) return;
   
@@ -92,7 +92,7 @@ void dog_draw_h_line(uint8_t x1, uint8_t x2, uint8_t y, uint8_t size, char mode)
   uint8_t i;
   
   /* Ensure parameters are properly set */
-  if(x1 >= DOG_WIDTH || x2 >= DOG_WIDTH || y >= DOG_HEIGHT) return;
+  if(x1 >= dog_width || x2 >= dog_width || y >= dog_height) return;
   if (mode != 'c' && mode != 's') return;
   if (size > 1) return;
   
@@ -116,7 +116,7 @@ void dog_draw_v_line(uint8_t x, uint8_t y1, uint8_t y2, uint8_t size, char mode)
   uint8_t i;
   
   /* Ensure parameters are properly set */
-  if(x >= DOG_WIDTH || y1 >= DOG_HEIGHT || y2 >= DOG_HEIGHT) return;
+  if(x >= dog_width || y1 >= dog_height || y2 >= dog_height) return;
   if (mode != 'c' && mode != 's') return;
   if (size > 1) return;
   
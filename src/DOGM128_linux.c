@@ -0,0 +1,305 @@
+/*
+ * @file   DOGM128_linux.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for driving the EA DOGM128 from Linux. <br>
+ * @defgroup DOGM128_linux_source
+ * @{
+ *
+ * This file contains the source code for the functions described in
+ * linux.h, along with the Linux versions of dog_spi_send_data(),
+ * dog_spi_configure() and dog_spi_autotune(). The user should include this
+ * file in his or her project when @b DOG_TRANSPORT is set to
+ * @b DOG_TRANSPORT_LINUX.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+#include <linux/spi/spidev.h>
+#include "DOGM128_linux.h"
+
+#if DOG_TRANSPORT != DOG_TRANSPORT_LINUX
+#error "DOGM128_linux.c requires DOG_TRANSPORT == DOG_TRANSPORT_LINUX"
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Transfers needed to send a full batch */
+#define DOG_LINUX_MAX_XFERS ((DOG_LINUX_BATCH_BYTES + DOG_LINUX_MAX_TRANSFER \
+                              - 1) / DOG_LINUX_MAX_TRANSFER)
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static int spi_fd
+ * @brief File descriptor of the spidev device.
+ *
+ * @var static int lines_fd
+ * @brief File descriptor of the requested GPIO lines.
+ *
+ * @var static uint8_t has_reset
+ * @brief Set when the reset pin is wired to a GPIO line.
+ *
+ * @var static uint8_t a0_level
+ * @brief Level of A0 for the bytes being queued.
+ *
+ * @var static uint8_t a0_line_level
+ * @brief Level last written to the A0 line.
+ *
+ * @var static uint8_t reset_level
+ * @brief Level of the reset line.
+ *
+ * @var static uint32_t speed_hz
+ * @brief SCK frequency requested for every transfer.
+ *
+ * @var static uint8_t batch[]
+ * @brief Bytes queued for sending, all with the level @b a0_level.
+ *
+ * @var static uint16_t batch_count
+ * @brief Number of bytes in @b batch.
+ */
+static int spi_fd = -1;
+static int lines_fd = -1;
+static uint8_t has_reset = 0;
+static uint8_t a0_level = 0;
+static uint8_t a0_line_level = 0;
+static uint8_t reset_level = 1;
+static uint32_t speed_hz = DOG_MAX_SCK_HZ;
+static uint8_t batch[DOG_LINUX_BATCH_BYTES];
+static uint16_t batch_count = 0;
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is the default for @b dog_linux_ioctl.
+ *
+ *  @par Parameters
+ *    - @a fd      = The file descriptor.
+ *    - @a request = The ioctl request code.
+ *    - @a arg     = The argument of the request.
+ *
+ *  @returns The return value of ioctl().
+ */
+static int dog_linux_sys_ioctl(int fd, unsigned long request, void *arg)
+{
+  return ioctl(fd, request, arg);
+}
+
+/** This function is used to write the A0 and reset lines.
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise it
+ *           returns -1.
+ */
+static int8_t dog_linux_write_lines(void)
+{
+  struct gpio_v2_line_values values;
+
+  /* Line 0 is A0 and line 1, when present, is reset */
+  values.mask = has_reset ? 3 : 1;
+  values.bits = a0_level | (reset_level << 1);
+  if(dog_linux_ioctl(lines_fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &values) < 0)
+    return -1;
+
+  a0_line_level = a0_level;
+  return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/* GLOBAL DATA                                                                */
+/*----------------------------------------------------------------------------*/
+int (*dog_linux_ioctl)(int fd, unsigned long request, void *arg) =
+  dog_linux_sys_ioctl;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int8_t dog_linux_open(const char *spi_device, const char *gpio_chip,
+                      uint32_t a0_line, int32_t reset_line)
+{
+  struct gpio_v2_line_request request;
+  int chip_fd;
+
+  spi_fd = open(spi_device, O_RDWR);
+  if(spi_fd < 0) return -1;
+
+  chip_fd = open(gpio_chip, O_RDWR);
+  if(chip_fd < 0)
+  {
+    close(spi_fd);
+    spi_fd = -1;
+    return -1;
+  }
+
+  /* Request A0 low and reset high, both as outputs */
+  memset(&request, 0, sizeof(request));
+  request.offsets[0] = a0_line;
+  request.num_lines = 1;
+  if(reset_line != DOG_LINUX_NO_RESET)
+  {
+    request.offsets[1] = reset_line;
+    request.num_lines = 2;
+  }
+  request.config.flags = GPIO_V2_LINE_FLAG_OUTPUT;
+  request.config.num_attrs = 1;
+  request.config.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+  request.config.attrs[0].attr.values = 2;
+  request.config.attrs[0].mask = (request.num_lines == 2) ? 3 : 1;
+  strncpy(request.consumer, "dogm128", sizeof(request.consumer) - 1);
+
+  if(dog_linux_ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &request) < 0)
+  {
+    close(chip_fd);
+    close(spi_fd);
+    spi_fd = -1;
+    return -1;
+  }
+  close(chip_fd);                  /* The line request outlives the chip fd */
+
+  lines_fd = request.fd;
+  has_reset = (request.num_lines == 2);
+  a0_level = a0_line_level = 0;
+  reset_level = 1;
+  batch_count = 0;
+  return 0;
+}
+
+void dog_linux_close(void)
+{
+  dog_linux_flush();
+  if(lines_fd >= 0) close(lines_fd);
+  if(spi_fd >= 0) close(spi_fd);
+  lines_fd = spi_fd = -1;
+}
+
+void dog_linux_transmit(uint8_t byte)
+{
+  if(batch_count == DOG_LINUX_BATCH_BYTES) dog_linux_flush();
+  batch[batch_count++] = byte;
+}
+
+void dog_linux_set_a0(uint8_t level)
+{
+  level &= 1;
+  if(level == a0_level) return;
+
+  dog_linux_flush();                /* Queued bytes keep their own level */
+  a0_level = level;
+}
+
+void dog_linux_set_reset(uint8_t level)
+{
+  dog_linux_flush();
+  reset_level = level & 1;
+  if(has_reset) dog_linux_write_lines();
+}
+
+int8_t dog_linux_flush(void)
+{
+  struct spi_ioc_transfer xfers[DOG_LINUX_MAX_XFERS];
+  uint16_t sent, n;
+  uint8_t count = 0;
+  int8_t result = 0;
+
+  if(!batch_count) return 0;
+
+  if(a0_line_level != a0_level && dog_linux_write_lines() < 0)
+  {
+    result = -1;
+  }
+  else
+  {
+    /* One message for the whole run, split at the driver's transfer limit */
+    memset(xfers, 0, sizeof(xfers));
+    for(sent = 0; sent < batch_count; sent += n)
+    {
+      n = batch_count - sent;
+      if(n > DOG_LINUX_MAX_TRANSFER) n = DOG_LINUX_MAX_TRANSFER;
+      xfers[count].tx_buf = (unsigned long)(batch + sent);
+      xfers[count].len = n;
+      xfers[count].speed_hz = speed_hz;
+      xfers[count].bits_per_word = 8;
+      ++count;
+    }
+    if(dog_linux_ioctl(spi_fd, SPI_IOC_MESSAGE(count), xfers) < 0)
+      result = -1;
+  }
+
+  batch_count = 0;
+  return result;
+}
+
+void dog_spi_send_data(const uint8_t *data, uint8_t count)
+{
+  uint16_t n;
+
+  DOG_SEND_DATA();
+  DOG_STAT_ADD(spi_bytes, count);
+  while(count)
+  {
+    if(batch_count == DOG_LINUX_BATCH_BYTES) dog_linux_flush();
+
+    /* Copy as much of the run as fits into the batch */
+    n = DOG_LINUX_BATCH_BYTES - batch_count;
+    if(n > count) n = count;
+    memcpy(batch + batch_count, data, n);
+    batch_count += n;
+    data += n;
+    count -= n;
+  }
+}
+
+int8_t dog_spi_configure(const dog_spi_config_t *config)
+{
+  uint8_t mode = SPI_MODE_0;
+  uint8_t bits = 8;
+  uint8_t lsb_first = (config->bit_order == DOG_LSB_FIRST);
+  uint32_t speed;
+
+  /* The divider must be a power of two in [2,128] */
+  if(config->bitbang) return -1;
+  if(config->divider < 2 || config->divider > 128 ||
+     (config->divider & (config->divider - 1)))
+    return -1;
+
+  /* The kernel derives SCK from its own clock; divider 2 is the fastest
+   * clock the DOG module accepts.
+   */
+  speed = DOG_MAX_SCK_HZ / (config->divider >> 1);
+
+  dog_linux_flush();
+  if(dog_linux_ioctl(spi_fd, SPI_IOC_WR_MODE, &mode) < 0 ||
+     dog_linux_ioctl(spi_fd, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0 ||
+     dog_linux_ioctl(spi_fd, SPI_IOC_WR_LSB_FIRST, &lsb_first) < 0 ||
+     dog_linux_ioctl(spi_fd, SPI_IOC_WR_MAX_SPEED_HZ, &speed) < 0)
+    return -1;
+
+  speed_hz = speed;
+  return 0;
+}
+
+uint8_t dog_spi_autotune(uint32_t f_cpu)
+{
+  dog_spi_config_t config;
+
+  (void)f_cpu;
+
+  /* The SPI controller rounds the requested clock down on its own */
+  config.divider = 2;
+  config.bit_order = DOG_MSB_FIRST;
+  config.bitbang = 0;
+  dog_spi_configure(&config);
+  return config.divider;
+}
+
+/* @} */ /* DOGM128_linux_source */
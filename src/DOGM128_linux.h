@@ -0,0 +1,118 @@
+/**
+ * @file   DOGM128_linux.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Header file for driving the EA DOGM128 from Linux. <br>
+ * @defgroup DOGM128_linux Linux Transport
+ * @{
+ *
+ * This file contains function prototypes for talking to the DOG module
+ * through /dev/spidev and a GPIO character device (/dev/gpiochipN) instead
+ * of the registers of a microcontroller. It is used when @b DOG_TRANSPORT is
+ * set to @b DOG_TRANSPORT_LINUX; the rest of the library is unchanged.
+ *
+ * System calls are expensive compared to the bytes they carry, so bytes are
+ * not sent as they are transmitted. They are collected until the level of A0
+ * has to change, or until the DOG module is deselected at the end of an
+ * operation, and each run is then sent with a single SPI_IOC_MESSAGE ioctl.
+ * A0 is only written when a run with a different level is sent. A full
+ * dog_print_buffer() thus takes one ioctl per page for the data, one per page
+ * for the address commands, and one per A0 change.
+ *
+ * All ioctls go through @b dog_linux_ioctl, which may be pointed at a stand-in
+ * in order to run the library against an emulated controller.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_LINUX_H
+#define DOGM128_LINUX_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Passed to dog_linux_open() when the reset pin is not wired to a GPIO */
+#define DOG_LINUX_NO_RESET (-1)
+
+/*----------------------------------------------------------------------------*/
+/* EXTERNAL DATA                                                              */
+/*----------------------------------------------------------------------------*/
+/** Function used for every ioctl() of the transport. Defaults to a wrapper
+ *  around ioctl(); point it at another function to intercept the traffic.
+ */
+extern int (*dog_linux_ioctl)(int fd, unsigned long request, void *arg);
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to open the devices the DOG module is attached to.
+ *  It must be called before dog_init().
+ *
+ *  @par Parameters
+ *         - @a spi_device  = Path of the spidev device, e.g. "/dev/spidev0.0".
+ *         - @a gpio_chip   = Path of the GPIO chip, e.g. "/dev/gpiochip0".
+ *         - @a a0_line     = Line offset of the A0 pin on @a gpio_chip.
+ *         - @a reset_line  = Line offset of the reset pin on @a gpio_chip, or
+ *                            @b DOG_LINUX_NO_RESET.
+ *
+ *  @par Algorithm
+ *       Opens both devices and requests the lines as outputs, with A0 low and
+ *       reset high, through the GPIO v2 character device interface.
+ *
+ *  @par Assumptions
+ *       - The user has permission to access both devices.
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise it
+ *           returns -1 and nothing is left open.
+ */
+int8_t dog_linux_open(const char *spi_device, const char *gpio_chip,
+                      uint32_t a0_line, int32_t reset_line);
+
+/** This function is used to send anything still queued and close the devices.
+ */
+void dog_linux_close(void);
+
+/** This function is used to queue one byte for the DOG module. It is called
+ *  by DOG_SPI_TRANSMIT() and should not normally be called directly.
+ *
+ *  @par Parameters
+ *         - @a byte = The byte to be sent with the current level of A0.
+ */
+void dog_linux_transmit(uint8_t byte);
+
+/** This function is used to select between commands (0) and data (1). It is
+ *  called by DOG_SEND_COMMAND() and DOG_SEND_DATA().
+ *
+ *  @par Parameters
+ *         - @a level = The level of A0 for the following bytes.
+ *
+ *  @par Algorithm
+ *       If bytes of the other level are queued, they are sent first. The A0
+ *       line itself is only written when the next run is sent.
+ */
+void dog_linux_set_a0(uint8_t level);
+
+/** This function is used to drive the reset pin. It is called by
+ *  DOG_ASSERT_RESET() and DOG_UNASSERT_RESET().
+ *
+ *  @par Parameters
+ *         - @a level = The level of the reset pin (active low).
+ */
+void dog_linux_set_reset(uint8_t level);
+
+/** This function is used to send every queued byte to the DOG module. It is
+ *  called by DOG_SLAVE_DESELECT() at the end of every operation.
+ *
+ *  @returns Upon successful completion, the function returns zero. If an
+ *           ioctl() fails, it returns -1 and the queued bytes are dropped.
+ */
+int8_t dog_linux_flush(void);
+
+#endif /* DOGM128_LINUX_H */
+/** @} */ /* DOGM128_linux */
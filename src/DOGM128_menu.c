@@ -0,0 +1,166 @@
+/*
+ * @file   DOGM128_menu.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for menus and lists on the EA DOGM128. <br>
+ * @defgroup DOGM128_menu_source
+ * @{
+ *
+ * This file contains the source code for the functions described in
+ * menu.h. The user should include this file, along with characters.c,
+ * rectangle.c and scroll.c, in his or her project should they choose to use
+ * menus.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_menu.h"
+#include "DOGM128_characters.h"
+#include "DOGM128_rectangle.h"
+#include "DOGM128_scroll.h"
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to invert the row of a visible item.
+ *
+ *  @par Parameters
+ *    - @a menu  = The menu.
+ *    - @a index = Index of the item.
+ */
+static void dog_menu_invert(const dog_menu_t *menu, uint16_t index)
+{
+  uint8_t y = (menu->page + (uint8_t)(index - menu->top)) << 3;
+
+  dog_fill_rectangle(menu->col, y, menu->col + menu->width - 1, y + 7, 'x');
+}
+
+/** This function is used to draw a visible item, inverted if selected.
+ *
+ *  @par Parameters
+ *    - @a menu  = The menu.
+ *    - @a index = Index of the item.
+ */
+static void dog_menu_row(const dog_menu_t *menu, uint16_t index)
+{
+  const char *text = (index < menu->count) ? menu->item(index) : 0;
+
+  dog_draw_string(menu->page + (uint8_t)(index - menu->top), menu->col,
+                  menu->width, DOG_ALIGN_LEFT, text ? text : "", 0);
+  if(index == menu->selected && index < menu->count)
+    dog_menu_invert(menu, index);
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int8_t dog_menu_init(dog_menu_t *menu,
+                     uint8_t page,
+                     uint8_t rows,
+                     uint8_t col,
+                     uint8_t width,
+                     uint16_t count,
+                     dog_menu_item_t item)
+{
+  /* Ensure the whole menu fits on the display */
+  if(page >= DOG_PAGE_HEIGHT || rows == 0 || rows > DOG_PAGE_HEIGHT - page)
+    return -1;
+  if(col >= DOG_WIDTH || width == 0 || width > DOG_WIDTH - col) return -1;
+
+  menu->page = page;
+  menu->rows = rows;
+  menu->col = col;
+  menu->width = width;
+  menu->count = count;
+  menu->top = 0;
+  menu->selected = 0;
+  menu->item = item;
+  return 0;
+}
+
+void dog_menu_draw(dog_menu_t *menu)
+{
+  uint8_t row;
+
+  for(row = 0; row < menu->rows; ++row)
+    dog_menu_row(menu, menu->top + row);
+}
+
+int8_t dog_menu_select(dog_menu_t *menu, uint16_t index, dog_span_t *span)
+{
+  uint16_t old = menu->selected;
+  uint8_t x2 = menu->col + menu->width - 1;
+  uint8_t y1 = menu->page << 3;
+  uint8_t y2 = y1 + (menu->rows << 3) - 1;
+
+  if(index >= menu->count) return -1;
+  if(index == old) return 0;
+
+  dog_menu_invert(menu, old);
+  menu->selected = index;
+
+  if(index >= menu->top && index < menu->top + menu->rows)
+  {
+    /* Only the two rows change */
+    dog_menu_invert(menu, index);
+    if(span)
+    {
+      span->page_start = menu->page + (uint8_t)(((old < index) ? old : index) -
+                                                menu->top);
+      span->page_end = menu->page + (uint8_t)(((old > index) ? old : index) -
+                                              menu->top);
+    }
+  }
+  else
+  {
+    /* One item above or below moves the others a page; should the scroll
+     * be refused, or for a jump, the menu is drawn again */
+    if(index + 1 == menu->top &&
+       dog_scroll_v(menu->col, y1, x2, y2, 8, 'c') == 0)
+    {
+      menu->top = index;
+      dog_menu_row(menu, index);
+    }
+    else if(index == menu->top + menu->rows &&
+            dog_scroll_v(menu->col, y1, x2, y2, -8, 'c') == 0)
+    {
+      menu->top = index - menu->rows + 1;
+      dog_menu_row(menu, index);
+    }
+    else
+    {
+      /* Bring the new item to the nearer edge */
+      menu->top = (index < menu->top) ? index : index - menu->rows + 1;
+      dog_menu_draw(menu);
+    }
+
+    if(span)
+    {
+      span->page_start = menu->page;
+      span->page_end = menu->page + menu->rows - 1;
+    }
+  }
+
+  if(span)
+  {
+    span->col_start = menu->col;
+    span->col_end = x2;
+  }
+  return 0;
+}
+
+int8_t dog_menu_move(dog_menu_t *menu, int16_t delta, dog_span_t *span)
+{
+  int32_t index = (int32_t)menu->selected + delta;
+
+  if(menu->count == 0) return -1;
+  if(index < 0) index = 0;
+  if(index >= menu->count) index = menu->count - 1;
+  return dog_menu_select(menu, (uint16_t)index, span);
+}
+
+/* @} */ /* DOGM128_menu_source */
@@ -0,0 +1,127 @@
+/**
+ * @file   DOGM128_menu.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Header file for menus and lists on the EA DOGM128. <br>
+ * @defgroup DOGM128_menu Menus
+ * @{
+ *
+ * This file contains function prototypes for scrolling menus and lists.
+ * Each item takes up one page of the buffer, and only the items which are
+ * visible are ever drawn: their text is fetched from a callback when needed,
+ * so a list may be far longer than the screen without being held in memory.
+ *
+ * The selected item is shown inverted. Moving the selection within the
+ * visible items inverts the old and the new page row again, which leaves
+ * only those two rows dirty. Moving it past the top or bottom scrolls the
+ * list by one item with dog_scroll_v() and draws only the item which comes
+ * into view.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_MENU_H
+#define DOGM128_MENU_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** used to fetch the text of an item; returns a null-terminated string, or
+ *  NULL for a blank row. The string is only read until the callback is
+ *  called again. */
+typedef const char *(*dog_menu_item_t)(uint16_t index);
+
+/** used to store the state of a menu between updates */
+typedef struct
+{
+  uint8_t page;             /**< page of the first visible item           */
+  uint8_t rows;             /**< number of visible items                  */
+  uint8_t col;              /**< left-hand column of the menu             */
+  uint8_t width;            /**< width of the menu in pixels              */
+  uint16_t count;           /**< number of items in the list              */
+  uint16_t top;             /**< index of the first visible item          */
+  uint16_t selected;        /**< index of the selected item               */
+  dog_menu_item_t item;     /**< fetches the text of an item              */
+} dog_menu_t;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to set up a menu with the first item selected.
+ *  Nothing is drawn until dog_menu_draw() is called.
+ *
+ *  @par Parameters
+ *         - @a menu  = The menu to be set up.
+ *         - @a page  = Page of the first visible item [0,7].
+ *         - @a rows  = Number of visible items [1,8-page].
+ *         - @a col   = Left-hand column of the menu [0,127].
+ *         - @a width = Width of the menu in pixels [1,128-col].
+ *         - @a count = Number of items in the list.
+ *         - @a item  = Fetches the text of an item.
+ *
+ *  @returns Upon successful completion, the function returns zero. It returns
+ *           -1 if the menu does not fit on the display.
+ */
+int8_t dog_menu_init(dog_menu_t *menu,
+                     uint8_t page,
+                     uint8_t rows,
+                     uint8_t col,
+                     uint8_t width,
+                     uint16_t count,
+                     dog_menu_item_t item);
+
+/** This function is used to draw every visible item of a menu, e.g. when it
+ *  is first shown or after the items have changed.
+ *
+ *  @par Assumptions
+ *       - The orientation is one of the landscape modes.
+ */
+void dog_menu_draw(dog_menu_t *menu);
+
+/** This function is used to select an item of a menu.
+ *
+ *  @par Parameters
+ *         - @a menu  = The menu.
+ *         - @a index = Index of the item to be selected.
+ *         - @a span  = Optional (may be NULL). Receives the region of the
+ *                      buffer that was rewritten.
+ *
+ *  @par Algorithm
+ *       The highlight is removed from the old item by inverting its row.
+ *       If the new item is visible, its row is inverted in turn. If it is
+ *       the item just above or below the visible ones, the menu is scrolled
+ *       by one page with dog_scroll_v() and only the new item is drawn.
+ *       Otherwise, or if the scroll is refused, every visible item is drawn
+ *       again.
+ *
+ *  @par Assumptions
+ *       - The menu has been drawn with dog_menu_draw().
+ *       - Nothing else draws inside the menu.
+ *
+ *  @returns Upon successful completion, the function returns zero. It returns
+ *           -1 if @a index is out of range. @a span is only written when
+ *           the selection moved.
+ */
+int8_t dog_menu_select(dog_menu_t *menu, uint16_t index, dog_span_t *span);
+
+/** This function is used to move the selection of a menu up or down, e.g.
+ *  in response to a key. The selection stops at the first and last items.
+ *
+ *  @par Parameters
+ *         - @a menu  = The menu.
+ *         - @a delta = Number of items to move by; negative moves up.
+ *         - @a span  = As for dog_menu_select().
+ *
+ *  @returns As for dog_menu_select().
+ */
+int8_t dog_menu_move(dog_menu_t *menu, int16_t delta, dog_span_t *span);
+
+#endif /* DOGM128_MENU_H */
+/** @} */ /* DOGM128_menu */
@@ -0,0 +1,208 @@
+/*
+ * @file   DOGM128_numeric.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for drawing numbers on the EA DOGM128 without printf.
+ *         <br>
+ * @defgroup DOGM128_numeric_source
+ * @{
+ *
+ * This file contains the source code for the functions described in
+ * numeric.h. The user should include this file in his or her project
+ * should they choose to draw numbers without the help of printf().
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_numeric.h"
+
+/*----------------------------------------------------------------------------*/
+/* CONSTANTS                                                                  */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var const uint32_t dog_powers_of_ten[]
+ * @brief Powers of ten used to extract digits by repeated subtraction.
+ */
+static const uint32_t dog_powers_of_ten[] =
+{
+  1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL,
+  10000UL, 1000UL, 100UL, 10UL, 1UL
+};
+
+/** Number of entries in dog_powers_of_ten[] */
+#define DOG_NUM_DIGITS 10
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+uint8_t dog_format_fixed(char *out,
+                         int32_t value,
+                         uint8_t decimals,
+                         uint8_t width,
+                         uint8_t flags)
+{
+  char digits[DOG_NUM_DIGITS];
+  uint32_t magnitude;
+  uint8_t n_digits = 0;
+  uint8_t i, len, pad;
+  char sign = 0;
+  char digit;
+  char *p = out;
+
+  if(decimals >= DOG_NUM_DIGITS) decimals = DOG_NUM_DIGITS - 1;
+  if(width > DOG_NUM_MAX_CHARS) width = DOG_NUM_MAX_CHARS;
+
+  /* Determine the sign; negate as unsigned so the most negative value works */
+  if(value < 0)
+  {
+    sign = '-';
+    magnitude = 0UL - (uint32_t)value;
+  }
+  else
+  {
+    if(flags & DOG_NUM_PLUS) sign = '+';
+    magnitude = (uint32_t)value;
+  }
+
+  /* Extract the digits by repeated subtraction, skipping leading zeros but
+   * keeping at least one digit ahead of the decimal point.
+   */
+  for(i = 0; i < DOG_NUM_DIGITS; ++i)
+  {
+    digit = '0';
+    while(magnitude >= dog_powers_of_ten[i])
+    {
+      magnitude -= dog_powers_of_ten[i];
+      ++digit;
+    }
+    if(n_digits || digit != '0' || i >= DOG_NUM_DIGITS - 1 - decimals)
+      digits[n_digits++] = digit;
+  }
+
+  /* Total length of sign, digits and decimal point */
+  len = n_digits + (sign ? 1 : 0) + (decimals ? 1 : 0);
+
+  if(width && len > width)              /* Does not fit; mark the overflow */
+  {
+    for(i = 0; i < width; ++i) *p++ = DOG_NUM_OVERFLOW;
+    *p = 0;
+    return width;
+  }
+
+  pad = (width > len) ? width - len : 0;
+
+  if(!(flags & (DOG_NUM_LEFT | DOG_NUM_ZERO_PAD)))
+    while(pad) { *p++ = ' '; --pad; }   /* Right-justify with spaces */
+
+  if(sign) *p++ = sign;
+
+  if(flags & DOG_NUM_ZERO_PAD && !(flags & DOG_NUM_LEFT))
+    while(pad) { *p++ = '0'; --pad; }   /* Zeros go between sign and digits */
+
+  for(i = 0; i < n_digits; ++i)
+  {
+    if(decimals && i == n_digits - decimals) *p++ = '.';
+    *p++ = digits[i];
+  }
+
+  while(pad) { *p++ = ' '; --pad; }     /* Left-justify with spaces */
+
+  *p = 0;
+  return (uint8_t)(p - out);
+}
+
+uint8_t dog_format_int(char *out, int32_t value, uint8_t width, uint8_t flags)
+{
+  return dog_format_fixed(out, value, 0, width, flags);
+}
+
+int8_t dog_draw_fixed(uint8_t page,
+                      uint8_t col,
+                      int32_t value,
+                      uint8_t decimals,
+                      uint8_t width,
+                      uint8_t flags,
+                      dog_span_t *span)
+{
+  char text[DOG_NUM_MAX_CHARS + 1];
+
+  dog_format_fixed(text, value, decimals, width, flags);
+  return dog_draw_string(page, col, 0, DOG_ALIGN_LEFT, text, span);
+}
+
+int8_t dog_draw_int(uint8_t page,
+                    uint8_t col,
+                    int32_t value,
+                    uint8_t width,
+                    uint8_t flags,
+                    dog_span_t *span)
+{
+  return dog_draw_fixed(page, col, value, 0, width, flags, span);
+}
+
+int8_t dog_numeric_field_init(dog_numeric_field_t *field,
+                              uint8_t page,
+                              uint8_t col,
+                              uint8_t width,
+                              uint8_t decimals,
+                              uint8_t flags)
+{
+  /* Ensure the whole field fits on the display */
+  if(page >= DOG_CHAR_HEIGHT) return -1;
+  if(width == 0 || width > DOG_NUM_MAX_CHARS) return -1;
+  if(col + width*DOG_GLYPH_ADVANCE - 1 > DOG_WIDTH) return -1;
+
+  field->page = page;
+  field->col = col;
+  field->width = width;
+  field->decimals = decimals;
+  field->flags = flags;
+  dog_numeric_field_invalidate(field);
+  return 0;
+}
+
+uint8_t dog_numeric_field_update(dog_numeric_field_t *field,
+                                 int32_t value,
+                                 dog_span_t *span)
+{
+  char text[DOG_NUM_MAX_CHARS + 1];
+  uint8_t i, first = 0, last = 0, changed = 0;
+  uint8_t col = field->col;
+
+  dog_format_fixed(text, value, field->decimals, field->width, field->flags);
+
+  /* Redraw only the characters that differ from what is on the screen */
+  for(i = 0; i < field->width; ++i, col += DOG_GLYPH_ADVANCE)
+  {
+    if(text[i] != field->shown[i])
+    {
+      dog_draw_glyph(field->page, col, text[i]);
+      field->shown[i] = text[i];
+      if(!changed) first = i;
+      last = i;
+      ++changed;
+    }
+  }
+
+  if(changed && span)
+  {
+    span->page_start = field->page;
+    span->page_end   = field->page;
+    span->col_start  = field->col + first*DOG_GLYPH_ADVANCE;
+    span->col_end    = field->col + last*DOG_GLYPH_ADVANCE + DOG_GLYPH_WIDTH-1;
+  }
+  return changed;
+}
+
+void dog_numeric_field_invalidate(dog_numeric_field_t *field)
+{
+  uint8_t i;
+
+  /* Zero never comes out of the formatter, so every character will differ */
+  for(i = 0; i < DOG_NUM_MAX_CHARS; ++i) field->shown[i] = 0;
+}
+
+/* @} */ /* DOGM128_numeric_source */
@@ -0,0 +1,188 @@
+/**
+ * @file   DOGM128_numeric.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Header file for drawing numbers on the EA DOGM128 without printf.<br>
+ * @defgroup DOGM128_numeric Numbers
+ * @{
+ *
+ * This file contains function prototypes for formatting integers and
+ * fixed-point numbers and drawing them straight into the screen buffer. It is
+ * meant to replace printf() for numeric readouts, which saves both time and
+ * the code space taken up by the stdio formatter. It also contains the
+ * numeric field, which remembers what it last drew so that only the
+ * characters which changed are redrawn on each update.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_NUMERIC_H
+#define DOGM128_NUMERIC_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_common.h"
+#include "DOGM128_characters.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Maximum number of characters produced by the formatter. A 32-bit number
+  * needs 10 digits, a sign and a decimal point.
+  */
+#define DOG_NUM_MAX_CHARS 12
+
+/** Formatting flag: always print the sign, even for positive numbers */
+#define DOG_NUM_PLUS      0x01
+/** Formatting flag: pad with zeros (after the sign) rather than spaces */
+#define DOG_NUM_ZERO_PAD  0x02
+/** Formatting flag: left-justify the number within its width */
+#define DOG_NUM_LEFT      0x04
+
+/** Character used to fill a field when the number does not fit in it */
+#define DOG_NUM_OVERFLOW  '#'
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** used to store the state of a numeric field between updates */
+typedef struct
+{
+  uint8_t page;                         /**< page of the field [0,7]        */
+  uint8_t col;                          /**< left-hand column of the field  */
+  uint8_t width;                        /**< width of the field in chars    */
+  uint8_t decimals;                     /**< number of decimal places       */
+  uint8_t flags;                        /**< DOG_NUM_* formatting flags     */
+  char shown[DOG_NUM_MAX_CHARS];        /**< characters currently drawn     */
+} dog_numeric_field_t;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to format a fixed-point number into a string.
+ *
+ *  @par Parameters
+ *         - @a out      = Buffer receiving the null-terminated string. It must
+ *                         hold at least @b DOG_NUM_MAX_CHARS + 1 characters.
+ *         - @a value    = The number to be formatted, scaled by
+ *                         10^@a decimals (e.g. 1234 with 2 decimals is
+ *                         formatted as "12.34").
+ *         - @a decimals = Number of digits following the decimal point [0,9].
+ *                         Zero formats @a value as a plain integer.
+ *         - @a width    = Minimum width of the result in characters
+ *                         [0,DOG_NUM_MAX_CHARS]. If the number is wider than a
+ *                         non-zero @a width, the result is filled with
+ *                         @b DOG_NUM_OVERFLOW instead.
+ *         - @a flags    = Any combination of @b DOG_NUM_PLUS,
+ *                         @b DOG_NUM_ZERO_PAD and @b DOG_NUM_LEFT.
+ *
+ *  @par Algorithm
+ *       The digits are extracted by repeatedly subtracting powers of ten, so
+ *       no division is needed. The decimal point, sign and padding are then
+ *       placed around the digits.
+ *
+ *  @par Assumptions
+ *       - None
+ *
+ *  @returns The length of the resulting string.
+ */
+uint8_t dog_format_fixed(char *out,
+                         int32_t value,
+                         uint8_t decimals,
+                         uint8_t width,
+                         uint8_t flags);
+
+/** This function is used to format an integer into a string. It is the same
+ *  as dog_format_fixed() with zero decimal places.
+ *
+ *  @returns The length of the resulting string.
+ */
+uint8_t dog_format_int(char *out, int32_t value, uint8_t width, uint8_t flags);
+
+/** This function is used to draw a fixed-point number directly into the
+ *  buffer. See dog_format_fixed() for a description of the formatting
+ *  parameters and dog_draw_string() for the placement parameters.
+ *
+ *  @returns The number of characters drawn upon successful completion, or -1
+ *           if @a page or @a col is out of range.
+ */
+int8_t dog_draw_fixed(uint8_t page,
+                      uint8_t col,
+                      int32_t value,
+                      uint8_t decimals,
+                      uint8_t width,
+                      uint8_t flags,
+                      dog_span_t *span);
+
+/** This function is used to draw an integer directly into the buffer. It is
+ *  the same as dog_draw_fixed() with zero decimal places.
+ *
+ *  @returns The number of characters drawn upon successful completion, or -1
+ *           if @a page or @a col is out of range.
+ */
+int8_t dog_draw_int(uint8_t page,
+                    uint8_t col,
+                    int32_t value,
+                    uint8_t width,
+                    uint8_t flags,
+                    dog_span_t *span);
+
+/** This function is used to set up a numeric field. Nothing is drawn until
+ *  the first call to dog_numeric_field_update().
+ *
+ *  @par Parameters
+ *         - @a field    = The field to be set up.
+ *         - @a page     = The page of the field [0,7].
+ *         - @a col      = The left-hand column of the field [0,127].
+ *         - @a width    = Width of the field in characters
+ *                         [1,DOG_NUM_MAX_CHARS].
+ *         - @a decimals = Number of digits following the decimal point.
+ *         - @a flags    = DOG_NUM_* formatting flags.
+ *
+ *  @par Assumptions
+ *       - None
+ *
+ *  @returns Upon successful completion, the function returns zero. It returns
+ *           -1 if the field does not fit on the display.
+ */
+int8_t dog_numeric_field_init(dog_numeric_field_t *field,
+                              uint8_t page,
+                              uint8_t col,
+                              uint8_t width,
+                              uint8_t decimals,
+                              uint8_t flags);
+
+/** This function is used to display a new value in a numeric field.
+ *
+ *  @par Parameters
+ *         - @a field = The field to be updated.
+ *         - @a value = The new value, scaled as in dog_format_fixed().
+ *         - @a span  = Optional (may be NULL). Receives the region of the
+ *                      buffer that was rewritten.
+ *
+ *  @par Algorithm
+ *       Formats the value and compares it character by character with what
+ *       the field currently shows. Only the characters which differ are
+ *       redrawn, so a readout whose last digit changes costs a single glyph.
+ *
+ *  @par Assumptions
+ *       - Nothing else draws over the field. If it does, call
+ *         dog_numeric_field_invalidate() to force a full redraw.
+ *
+ *  @returns The number of characters redrawn. @a span is only written when
+ *           this is non-zero.
+ */
+uint8_t dog_numeric_field_update(dog_numeric_field_t *field,
+                                 int32_t value,
+                                 dog_span_t *span);
+
+/** This function is used to force every character of a numeric field to be
+ *  redrawn on the next call to dog_numeric_field_update().
+ */
+void dog_numeric_field_invalidate(dog_numeric_field_t *field);
+
+#endif /* DOGM128_NUMERIC_H */
+/** @} */ /* DOGM128_numeric */
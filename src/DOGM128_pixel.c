@@ -22,11 +22,11 @@
 /* External Data                                                              */
 /*----------------------------------------------------------------------------*/
 /**
- * @var uint8_t dog_buffer[DOG_PAGE_HEIGHT][DOG_WIDTH]
+ * @var uint8_t (*dog_buffer)[DOG_WIDTH]
  * @brief External buffer used for storing screen contents before sending data
- *        to screen.
+ *        to screen (the current draw target).
  */
-extern uint8_t dog_buffer[DOG_PAGE_HEIGHT][DOG_WIDTH];
+extern uint8_t (*dog_buffer)[DOG_WIDTH];
 
 /*----------------------------------------------------------------------------*/
 /* Functions                                                                  */
@@ -35,18 +35,37 @@ extern uint8_t dog_buffer[DOG_PAGE_HEIGHT][DOG_WIDTH];
 int8_t dog_draw_pixel(uint8_t row, uint8_t col, char mode)
 {
   uint8_t page;                               /* Declare local variables */
+  uint8_t *byte;
 
   /* Ensure pixel position is not off the screen. Note that we do not
    * check for lower bounds since we are dealing with unsigned numbers
    */
-  if(row >= DOG_HEIGHT)
+  if(row >= dog_height)
     return -1;      /* return -1 if row is too large */
-  if(col >= DOG_WIDTH)
+  if(col >= dog_width)
     return -2;      /* return -2 if col is too large */
   
   
   /* Divide row by 8 and truncate to get page number,shift for efficiency */
   page = row >> 3; 
+
+  /* In portrait the buffer holds 16 pages of dog_width columns. It reaches
+   * the screen transposed, so the byte lands on page col / 8, column row.
+   */
+  if(dog_orientation >= DOG_ORIENT_90)
+  {
+    byte = &dog_buffer[0][0] + page * dog_width + col;
+    if(mode == 's')
+      *byte |= 1 << (row % DOG_PAGE_HEIGHT);
+    else if(mode == 'c')
+      *byte &= ~(1 << (row % DOG_PAGE_HEIGHT));
+    else
+      return -3;    /* Return -3 upon invalid mode parameter*/
+    DOG_MARK_DIRTY(col >> 3, row);
+    DOG_STAT_ADD(pixels, 1);
+    DOG_STAT_ADD(buffer_bytes, 1);
+    return 0;
+  }
   
   switch (mode) /* Switch on function mode (clear or set pixel) */
   {
@@ -61,14 +80,21 @@ int8_t dog_draw_pixel(uint8_t row, uint8_t col, char mode)
             * set on page 2 by computing 20 % 8, which equals 4.*/
            dog_buffer[page][col] =
              dog_buffer[page][col] | (1<<(row % DOG_PAGE_HEIGHT));
+           DOG_MARK_DIRTY(page, col);
+           DOG_STAT_ADD(pixels, 1);
+           DOG_STAT_ADD(buffer_bytes, 1);
            
            return 0;   /* Return 0 upon successful completion */
            
   case 'c': /* Clear Pixel */
   
-           /*See above comments, same logic applies */
-           dog_buffer[page][col] = 
-             dog_buffer[page][col] & (0<<(row % DOG_PAGE_HEIGHT));
+           /* See above comments; AND-ing with the inverted mask clears that
+            * one row and leaves the other seven in the page alone. */
+           dog_buffer[page][col] =
+             dog_buffer[page][col] & ~(1<<(row % DOG_PAGE_HEIGHT));
+           DOG_MARK_DIRTY(page, col);
+           DOG_STAT_ADD(pixels, 1);
+           DOG_STAT_ADD(buffer_bytes, 1);
            return 0;   /* Return 0 upon successful completion */
   default:
            return -3;  /* Return -3 upon invalid mode parameter*/
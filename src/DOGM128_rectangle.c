@@ -6,8 +6,9 @@
  * @defgroup DOGM128_rectangle_source
  * @{
  *
- * This file contains the source code for the dog_draw_rectangle() function, 
- * which is used to set or clear an unfilled rectangle.
+ * This file contains the source code for the dog_draw_rectangle() and 
+ * dog_fill_rectangle() functions, which are used to draw unfilled and filled
+ * rectangles.
  *
  */
 /*----------------------------------------------------------------------------*/
@@ -35,4 +36,58 @@ void dog_draw_rectangle(uint8_t x1,
 
 }
 
+int8_t dog_fill_rectangle(uint8_t x1,
+                          uint8_t y1,
+                          uint8_t x2,
+                          uint8_t y2,
+                          char mode)
+{
+  uint8_t temp, page, last_page, mask, n;
+  uint8_t *byte;
+
+  /* swap the coordinates so that (x1, y1) is the top-left corner */
+  if(x1 > x2)
+  {
+    temp = x1;
+    x1 = x2;
+    x2 = temp;
+  }
+  if(y1 > y2)
+  {
+    temp = y1;
+    y1 = y2;
+    y2 = temp;
+  }
+
+  /* Ensure parameters are properly set */
+  if(x2 >= DOG_WIDTH || y2 >= DOG_HEIGHT) return -1;
+  if(dog_orientation >= DOG_ORIENT_90) return -1;
+  if(mode != 's' && mode != 'c' && mode != 'x') return -1;
+
+  last_page = y2 >> 3;
+  for(page = y1 >> 3; page <= last_page; ++page)
+  {
+    /* Rows of the rectangle within this page */
+    mask = 0xFF;
+    if(page == (y1 >> 3)) mask &= (uint8_t)(0xFF << (y1 & 7));
+    if(page == last_page) mask &= (uint8_t)(0xFF >> (7 - (y2 & 7)));
+
+    byte = &dog_buffer[page][x1];
+    n = x2 - x1 + 1;
+    switch(mode)
+    {
+    case 's': do { *byte++ |= mask;  } while(--n); break;
+    case 'c': do { *byte++ &= ~mask; } while(--n); break;
+    default:  do { *byte++ ^= mask;  } while(--n); break;
+    }
+
+    DOG_MARK_DIRTY(page, x1);
+    DOG_MARK_DIRTY(page, x2);
+  }
+
+  DOG_STAT_ADD(buffer_bytes,
+               (uint16_t)(x2 - x1 + 1) * (last_page - (y1 >> 3) + 1));
+  return 0;
+}
+
 /* @} */ /* DOGM128_rectangle_source */
\ No newline at end of file
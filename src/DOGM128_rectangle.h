@@ -6,8 +6,10 @@
  * @defgroup DOGM128_rectangle Rectangle
  * @{
  *
- * This file contains the prototype for the dog_draw_rectangle() function, 
- * which is used to set or clear an unfilled rectangle.
+ * This file contains the prototypes for the dog_draw_rectangle() function, 
+ * which is used to set or clear an unfilled rectangle, and the
+ * dog_fill_rectangle() function, which is used to set, clear or invert a
+ * filled one.
  *
  */
 
@@ -50,5 +52,32 @@ void dog_draw_rectangle(uint8_t x1,
                      uint8_t size,
                         char mode);
 
+/** This function is used to set, clear or invert a filled rectangle.
+ *
+ *  @par Parameters
+ *    - @a x1 = X coordinate of one corner of the rectangle.[0,127]
+ *    - @a y1 = Y coordinate of one corner of the rectangle.[0,63]
+ *    - @a x2 = X coordinate of the opposite corner of the rectangle.[0,127]
+ *    - @a y2 = Y coordinate of the opposite corner of the rectangle.[0,63]
+ *    - @a mode = 's' for set, 'c' for clear, 'x' for invert
+ *
+ *  @par Algorithm
+ *       - Works on whole bytes of the buffer: the rows of the rectangle
+ *         within each page form a mask, which is applied to every column of
+ *         the rectangle on that page. A rectangle @a h rows high therefore
+ *         costs at most (h / 8 + 2) byte writes per column rather than @a h.
+ *
+ *  @par Assumptions
+ *       - The orientation is one of the landscape modes.
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise it
+ *           returns -1.
+ */
+int8_t dog_fill_rectangle(uint8_t x1,
+                          uint8_t y1,
+                          uint8_t x2,
+                          uint8_t y2,
+                          char mode);
+
 #endif /* DOGM128_RECTANGLE_H */
 /** @} */ /* DOGM128_rectangle */
\ No newline at end of file
@@ -0,0 +1,426 @@
+/*
+ * @file   DOGM128_remote.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for the remote framebuffer protocol of the EA DOGM128.
+ *         <br>
+ * @defgroup DOGM128_remote_source
+ * @{
+ *
+ * This file contains the source code for the functions described in
+ * remote.h. The user should include this file in his or her project should
+ * they choose to drive the buffer from another machine; the sender only
+ * needs the encoder and may leave the decoder unused.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <string.h>
+#include "DOGM128_remote.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/* States of the decoder */
+#define DOG_RX_SYNC     0   /* waiting for DOG_REMOTE_SYNC                  */
+#define DOG_RX_TYPE     1
+#define DOG_RX_LENGTH1  2
+#define DOG_RX_LENGTH2  3
+#define DOG_RX_PAGE     4   /* between the runs of a delta                  */
+#define DOG_RX_COL      5
+#define DOG_RX_COUNT    6
+#define DOG_RX_CONTROL  7   /* expecting a PackBits control byte            */
+#define DOG_RX_LITERAL  8
+#define DOG_RX_REPEAT   9
+#define DOG_RX_END      10  /* the frame is complete; no more payload       */
+#define DOG_RX_SKIP     11  /* discarding the rest of the payload           */
+#define DOG_RX_CRC      12
+
+/** Bytes of a run header; shorter gaps between changes are sent instead */
+#define DOG_REMOTE_RUN_HEADER 3
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to add a byte to a CRC-8 (polynomial 0x07).
+ *
+ *  @par Parameters
+ *    - @a crc  = The CRC so far.
+ *    - @a byte = The byte.
+ *
+ *  @returns The new CRC.
+ */
+static uint8_t dog_remote_crc(uint8_t crc, uint8_t byte)
+{
+  uint8_t bit;
+
+  crc ^= byte;
+  for(bit = 0; bit < 8; ++bit)
+    crc = (crc & 0x80) ? (uint8_t)(crc << 1) ^ 0x07 : (uint8_t)(crc << 1);
+  return crc;
+}
+
+/** This function is used to decide what follows the end of a PackBits chunk.
+ *
+ *  @par Parameters
+ *    - @a remote = The decoder.
+ */
+static void dog_remote_chunk_done(dog_remote_t *remote)
+{
+  if(remote->out_left)
+    remote->state = DOG_RX_CONTROL;
+  else
+    remote->state = (remote->type == DOG_REMOTE_KEY) ? DOG_RX_END
+                                                     : DOG_RX_PAGE;
+}
+
+/** This function is used to decode one byte of a payload.
+ *
+ *  @par Parameters
+ *    - @a remote = The decoder.
+ *    - @a byte   = The byte.
+ */
+static void dog_remote_payload(dog_remote_t *remote, uint8_t byte)
+{
+  uint8_t *dst = &dog_buffer[0][0] + remote->pos;
+
+  switch(remote->state)
+  {
+  case DOG_RX_PAGE:
+    remote->page = byte;
+    remote->state = (byte < DOG_PAGE_HEIGHT) ? DOG_RX_COL : DOG_RX_SKIP;
+    break;
+
+  case DOG_RX_COL:
+    remote->col = byte;
+    remote->state = (byte < DOG_WIDTH) ? DOG_RX_COUNT : DOG_RX_SKIP;
+    break;
+
+  case DOG_RX_COUNT:
+    if(byte == 0 || byte > DOG_WIDTH - remote->col)
+    {
+      remote->state = DOG_RX_SKIP;
+      break;
+    }
+    remote->pos = remote->page * DOG_WIDTH + remote->col;
+    remote->out_left = byte;
+    DOG_MARK_DIRTY(remote->page, remote->col);
+    DOG_MARK_DIRTY(remote->page, remote->col + byte - 1);
+    DOG_STAT_ADD(buffer_bytes, byte);
+    remote->state = DOG_RX_CONTROL;
+    break;
+
+  case DOG_RX_CONTROL:
+    if(byte == 128) break;
+    remote->pack = (byte < 128) ? byte + 1 : (uint8_t)(257 - byte);
+    if(remote->pack > remote->out_left)
+      remote->state = DOG_RX_SKIP;
+    else
+      remote->state = (byte < 128) ? DOG_RX_LITERAL : DOG_RX_REPEAT;
+    break;
+
+  case DOG_RX_LITERAL:
+    *dst = byte;
+    ++remote->pos;
+    --remote->out_left;
+    if(--remote->pack == 0) dog_remote_chunk_done(remote);
+    break;
+
+  case DOG_RX_REPEAT:
+    memset(dst, byte, remote->pack);
+    remote->pos += remote->pack;
+    remote->out_left -= remote->pack;
+    dog_remote_chunk_done(remote);
+    break;
+
+  default:                            /* More payload than the frame needs */
+    remote->state = DOG_RX_SKIP;
+    break;
+  }
+}
+
+/** This function is used to pack bytes in PackBits form. Repeats of three
+ *  bytes or more are packed; everything else is sent literally.
+ *
+ *  @par Parameters
+ *    - @a src  = The bytes.
+ *    - @a n    = Number of bytes.
+ *    - @a out  = Receives the packed bytes; NULL to only measure them.
+ *    - @a room = Space left in @a out.
+ *
+ *  @returns The number of bytes written, or 0 if they do not fit.
+ */
+static uint16_t dog_remote_pack(const uint8_t *src, uint16_t n,
+                                uint8_t *out, uint16_t room)
+{
+  uint16_t i = 0, written = 0, literal = 0;
+  uint8_t run;
+
+  while(i < n)
+  {
+    for(run = 1; i + run < n && run < 128 && src[i + run] == src[i]; ++run);
+
+    if(run >= 3 || literal == 128)
+    {
+      /* Close the pending literal chunk */
+      if(literal)
+      {
+        if(written + 1 + literal > room) return 0;
+        if(out)
+        {
+          out[written] = literal - 1;
+          memcpy(&out[written + 1], &src[i - literal], literal);
+        }
+        written += 1 + literal;
+        literal = 0;
+      }
+    }
+
+    if(run >= 3)
+    {
+      if(written + 2 > room) return 0;
+      if(out)
+      {
+        out[written] = (uint8_t)(257 - run);
+        out[written + 1] = src[i];
+      }
+      written += 2;
+      i += run;
+    }
+    else
+    {
+      ++literal;
+      ++i;
+    }
+  }
+
+  if(literal)
+  {
+    if(written + 1 + literal > room) return 0;
+    if(out)
+    {
+      out[written] = literal - 1;
+      memcpy(&out[written + 1], &src[i - literal], literal);
+    }
+    written += 1 + literal;
+  }
+  return written;
+}
+
+/** This function is used to add the header and CRC around a payload which
+ *  has been written at @a out + 4.
+ *
+ *  @par Parameters
+ *    - @a out    = The packet.
+ *    - @a type   = The packet type.
+ *    - @a length = Length of the payload.
+ *
+ *  @returns The length of the packet.
+ */
+static uint16_t dog_remote_seal(uint8_t *out, uint8_t type, uint16_t length)
+{
+  uint16_t i;
+  uint8_t crc = 0;
+
+  out[0] = DOG_REMOTE_SYNC;
+  out[1] = type;
+  out[2] = (uint8_t)length;
+  out[3] = (uint8_t)(length >> 8);
+  for(i = 1; i < length + 4; ++i) crc = dog_remote_crc(crc, out[i]);
+  out[length + 4] = crc;
+  return length + 5;
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+void dog_remote_init(dog_remote_t *remote)
+{
+  memset(remote, 0, sizeof(*remote));
+  remote->state = DOG_RX_SYNC;
+  remote->need_key = 1;
+}
+
+int8_t dog_remote_feed(dog_remote_t *remote, uint8_t byte)
+{
+  uint8_t complete;
+
+  switch(remote->state)
+  {
+  case DOG_RX_SYNC:
+    if(byte == DOG_REMOTE_SYNC)
+    {
+      remote->crc = 0;
+      remote->state = DOG_RX_TYPE;
+    }
+    return 0;
+
+  case DOG_RX_TYPE:
+    remote->crc = dog_remote_crc(remote->crc, byte);
+    remote->type = byte;
+    if(byte != DOG_REMOTE_KEY && byte != DOG_REMOTE_DELTA)
+    {
+      /* Not a packet after all; look for the next one */
+      remote->state = DOG_RX_SYNC;
+      return 0;
+    }
+    remote->state = DOG_RX_LENGTH1;
+    return 0;
+
+  case DOG_RX_LENGTH1:
+    remote->crc = dog_remote_crc(remote->crc, byte);
+    remote->length = byte;
+    remote->state = DOG_RX_LENGTH2;
+    return 0;
+
+  case DOG_RX_LENGTH2:
+    remote->crc = dog_remote_crc(remote->crc, byte);
+    remote->length |= (uint16_t)byte << 8;
+    remote->out_left = 0;
+
+    /* A damaged length must not swallow the packets which follow */
+    if(remote->length > DOG_REMOTE_MAX_PACKET - 5)
+    {
+      ++remote->errors;
+      remote->need_key = 1;
+      remote->state = DOG_RX_SYNC;
+      return -1;
+    }
+
+    if(remote->type == DOG_REMOTE_KEY)
+    {
+      remote->apply = 1;
+      remote->pos = 0;
+      remote->out_left = DOG_PAGE_HEIGHT * DOG_WIDTH;
+      dog_dirty_set_all(dog_dirty);
+      DOG_STAT_ADD(buffer_bytes, DOG_PAGE_HEIGHT * DOG_WIDTH);
+      remote->state = DOG_RX_CONTROL;
+    }
+    else
+    {
+      /* A delta is meaningless without the frame it is based on */
+      remote->apply = !remote->need_key;
+      remote->state = remote->apply ? DOG_RX_PAGE : DOG_RX_SKIP;
+    }
+    break;
+
+  case DOG_RX_CRC:
+    remote->state = DOG_RX_SYNC;
+    if(!remote->apply && remote->type == DOG_REMOTE_DELTA &&
+       remote->need_key && byte == remote->crc)
+    {
+      /* An intact delta ignored while waiting for a keyframe */
+      ++remote->skipped;
+      return 0;
+    }
+    if(remote->apply && byte == remote->crc)
+    {
+      ++remote->frames;
+      if(remote->type == DOG_REMOTE_KEY)
+      {
+        ++remote->keyframes;
+        remote->need_key = 0;
+      }
+      return DOG_REMOTE_FRAME;
+    }
+    ++remote->errors;
+    remote->need_key = 1;
+    return -1;
+
+  default:
+    remote->crc = dog_remote_crc(remote->crc, byte);
+    --remote->length;
+    if(remote->state != DOG_RX_SKIP) dog_remote_payload(remote, byte);
+    break;
+  }
+
+  if(remote->length == 0)
+  {
+    /* The payload must end between runs, or with a complete keyframe */
+    complete = (remote->state == DOG_RX_END) ||
+               (remote->state == DOG_RX_PAGE && remote->type ==
+                DOG_REMOTE_DELTA);
+    if(!complete) remote->apply = 0;
+    remote->state = DOG_RX_CRC;
+  }
+  return 0;
+}
+
+uint16_t dog_remote_encode_key(uint8_t (*frame)[DOG_WIDTH],
+                               uint8_t (*sent)[DOG_WIDTH],
+                               uint8_t *out,
+                               uint16_t size)
+{
+  uint16_t length;
+
+  if(size < 5) return 0;
+  length = dog_remote_pack(&frame[0][0], DOG_PAGE_HEIGHT * DOG_WIDTH,
+                           out + 4, size - 5);
+  if(length == 0) return 0;
+
+  if(sent) memcpy(sent, frame, DOG_PAGE_HEIGHT * DOG_WIDTH);
+  return dog_remote_seal(out, DOG_REMOTE_KEY, length);
+}
+
+uint16_t dog_remote_encode(uint8_t (*frame)[DOG_WIDTH],
+                           uint8_t (*sent)[DOG_WIDTH],
+                           uint8_t *out,
+                           uint16_t size)
+{
+  uint16_t length = 0, room, packed;
+  uint8_t page, first, last, col;
+  uint8_t changed = 0;
+
+  /* Stop at the size of an uncompressed keyframe */
+  room = (size < DOG_REMOTE_MAX_PACKET) ? size : DOG_REMOTE_MAX_PACKET;
+  room = (room > 5) ? room - 5 : 0;
+
+  for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+  {
+    col = 0;
+    while(col < DOG_WIDTH)
+    {
+      /* Find the next changed byte */
+      while(col < DOG_WIDTH && frame[page][col] == sent[page][col]) ++col;
+      if(col == DOG_WIDTH) break;
+
+      /* Extend the run over gaps shorter than a run header */
+      first = last = col;
+      for(++col; col < DOG_WIDTH; ++col)
+      {
+        if(frame[page][col] == sent[page][col]) continue;
+        if(col - last - 1 > DOG_REMOTE_RUN_HEADER) break;
+        last = col;
+      }
+      col = last + 1;
+      changed = 1;
+
+      if(length + DOG_REMOTE_RUN_HEADER > room)
+        return dog_remote_encode_key(frame, sent, out, size);
+      out[4 + length++] = page;
+      out[4 + length++] = first;
+      out[4 + length++] = last - first + 1;
+
+      packed = dog_remote_pack(&frame[page][first], last - first + 1,
+                               out + 4 + length, room - length);
+      if(packed == 0) return dog_remote_encode_key(frame, sent, out, size);
+      length += packed;
+    }
+  }
+
+  if(!changed) return 0;
+
+  /* A keyframe which packs into no more than the delta is sent instead;
+   * measuring it stops as soon as it outgrows the delta */
+  if(dog_remote_pack(&frame[0][0], DOG_PAGE_HEIGHT * DOG_WIDTH, 0, length))
+    return dog_remote_encode_key(frame, sent, out, size);
+
+  memcpy(sent, frame, DOG_PAGE_HEIGHT * DOG_WIDTH);
+  return dog_remote_seal(out, DOG_REMOTE_DELTA, length);
+}
+
+/* @} */ /* DOGM128_remote_source */
@@ -0,0 +1,164 @@
+/**
+ * @file   DOGM128_remote.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Header file for the remote framebuffer protocol of the EA DOGM128.
+ *         <br>
+ * @defgroup DOGM128_remote Remote Framebuffer
+ * @{
+ *
+ * This file contains function prototypes for driving the buffer from another
+ * machine over a serial line, e.g. a PC driving a kiosk display or a test
+ * rig. The sender encodes each frame as the difference from the frame it
+ * sent before; the receiver feeds the bytes it receives to
+ * dog_remote_feed(), which writes them straight into @b dog_buffer and marks
+ * them dirty, and flushes when a frame is complete. The decoder keeps a few
+ * bytes of state and needs no packet buffer.
+ *
+ * A packet is made up of:
+ *   - @b DOG_REMOTE_SYNC
+ *   - the type, @b DOG_REMOTE_KEY or @b DOG_REMOTE_DELTA
+ *   - the length of the payload, two bytes, least significant first
+ *   - the payload
+ *   - a CRC-8 (polynomial 0x07) of the type, length and payload
+ *
+ * The payload of a keyframe is the whole buffer, page 0 first, in PackBits
+ * form: a control byte n in [0,127] is followed by n + 1 literal bytes, one
+ * in [129,255] by one byte to be repeated 257 - n times; 128 is ignored.
+ * The payload of a delta is any number of runs, each of them a page, a
+ * column and a count of bytes [1,128-column], followed by those bytes in
+ * PackBits form. A delta with no runs is a frame with no changes.
+ *
+ * Deltas are ignored until a keyframe has been received, and again after a
+ * packet was lost or damaged; a sender without a return channel should
+ * therefore send a keyframe now and then. Since bytes are written as they
+ * arrive, a damaged packet may leave part of a frame in the buffer.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_REMOTE_H
+#define DOGM128_REMOTE_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** First byte of every packet */
+#define DOG_REMOTE_SYNC   0xA5
+/** Packet type of a keyframe */
+#define DOG_REMOTE_KEY    'K'
+/** Packet type of a delta */
+#define DOG_REMOTE_DELTA  'D'
+
+/** Largest packet the encoder produces: the header, a keyframe which did
+ *  not compress at all, and the CRC */
+#define DOG_REMOTE_MAX_PACKET                                              \
+        (4 + DOG_PAGE_HEIGHT * DOG_WIDTH + DOG_PAGE_HEIGHT * DOG_WIDTH / 128 \
+         + 1 + 1)
+
+/** Returned by dog_remote_feed() when a frame is complete */
+#define DOG_REMOTE_FRAME  1
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** used to store the state of a decoder between bytes */
+typedef struct
+{
+  uint8_t state;            /**< part of the packet expected next          */
+  uint8_t type;             /**< type of the packet being received         */
+  uint8_t crc;              /**< CRC of the packet so far                  */
+  uint8_t apply;            /**< zero if the packet is being skipped       */
+  uint8_t need_key;         /**< non-zero until a keyframe is received     */
+  uint16_t length;          /**< bytes of the payload still to come        */
+  uint16_t pos;             /**< offset in the buffer of the next byte     */
+  uint16_t out_left;        /**< bytes of the run still to be written      */
+  uint8_t page;             /**< page of the run                           */
+  uint8_t col;              /**< first column of the run                   */
+  uint8_t pack;             /**< bytes of the PackBits chunk still to come */
+  uint16_t frames;          /**< frames received                           */
+  uint16_t keyframes;       /**< keyframes received                        */
+  uint16_t errors;          /**< packets damaged                           */
+  uint16_t skipped;         /**< deltas ignored while awaiting a keyframe  */
+} dog_remote_t;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to set up a decoder, which then waits for a
+ *  keyframe.
+ */
+void dog_remote_init(dog_remote_t *remote);
+
+/** This function is used to decode one byte received from the sender.
+ *
+ *  @par Parameters
+ *         - @a remote = The decoder.
+ *         - @a byte   = The byte received.
+ *
+ *  @par Algorithm
+ *       Steps a state machine through the packet. Payload bytes are
+ *       expanded into @b dog_buffer as they arrive; the start and end of
+ *       each run are marked dirty when its header is read.
+ *
+ *  @par Assumptions
+ *       - The draw target is a whole buffer of @b DOG_PAGE_HEIGHT pages.
+ *
+ *  @returns @b DOG_REMOTE_FRAME when a packet has been received and written
+ *           in full; the caller should then flush the buffer. It returns -1
+ *           when a packet was damaged, and 0 otherwise, including when an
+ *           intact delta is ignored while waiting for a keyframe (counted
+ *           in @a skipped).
+ */
+int8_t dog_remote_feed(dog_remote_t *remote, uint8_t byte);
+
+/** This function is used to encode a keyframe.
+ *
+ *  @par Parameters
+ *         - @a frame = The frame to be sent.
+ *         - @a sent  = Optional (may be NULL). Receives a copy of @a frame,
+ *                      for the next call to dog_remote_encode().
+ *         - @a out   = Receives the packet.
+ *         - @a size  = Size of @a out; @b DOG_REMOTE_MAX_PACKET is always
+ *                      enough.
+ *
+ *  @returns The length of the packet, or 0 if it does not fit in @a out.
+ */
+uint16_t dog_remote_encode_key(uint8_t (*frame)[DOG_WIDTH],
+                               uint8_t (*sent)[DOG_WIDTH],
+                               uint8_t *out,
+                               uint16_t size);
+
+/** This function is used to encode a frame as the difference from the last
+ *  frame sent.
+ *
+ *  @par Parameters
+ *         - @a frame = The frame to be sent.
+ *         - @a sent  = The last frame sent; updated to @a frame.
+ *         - @a out   = Receives the packet.
+ *         - @a size  = Size of @a out; @b DOG_REMOTE_MAX_PACKET is always
+ *                      enough.
+ *
+ *  @par Algorithm
+ *       Each page is compared with @a sent. Changed bytes closer together
+ *       than the three bytes of a run header are joined into one run. If
+ *       the delta would not be smaller than a keyframe, a keyframe is sent
+ *       instead; this also lets a receiver which lost a packet resume.
+ *
+ *  @returns The length of the packet, or 0 if nothing changed (or the packet
+ *           does not fit in @a out).
+ */
+uint16_t dog_remote_encode(uint8_t (*frame)[DOG_WIDTH],
+                           uint8_t (*sent)[DOG_WIDTH],
+                           uint8_t *out,
+                           uint16_t size);
+
+#endif /* DOGM128_REMOTE_H */
+/** @} */ /* DOGM128_remote */
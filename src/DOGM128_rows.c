@@ -0,0 +1,304 @@
+/*
+ * @file   DOGM128_rows.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for drawing into a row-major working buffer. <br>
+ * @defgroup DOGM128_rows_source
+ * @{
+ *
+ * This file contains the source code for the functions described in
+ * rows.h. The user should include this file in his or her project
+ * should they choose to draw in the row-major layout, and set
+ * @b DOG_ROW_MAJOR in DOGM128_user_config.h. Note that it holds a second
+ * 1 KB buffer.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_rows.h"
+
+#if DOG_ROW_MAJOR
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** A word with every bit set */
+#define DOG_ROW_ONES ((dog_row_word_t)~(dog_row_word_t)0)
+
+/*----------------------------------------------------------------------------*/
+/* GLOBAL DATA                                                                */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var dog_row_word_t dog_rows[DOG_HEIGHT][DOG_ROW_WORDS]
+ * @brief Row-major working buffer.
+ */
+dog_row_word_t dog_rows[DOG_HEIGHT][DOG_ROW_WORDS];
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static dog_dirty_t rows_dirty
+ * @brief Columns of each page changed since the last dog_rows_commit().
+ */
+static dog_dirty_t rows_dirty = DOG_DIRTY_CLEAN;
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to apply a mask to a word of the buffer.
+ *
+ *  @par Parameters
+ *    - @a word = The word to be changed.
+ *    - @a mask = The bits to be changed.
+ *    - @a mode = 's' to set, 'c' to clear or 'x' to invert the bits.
+ */
+static void dog_rows_apply(dog_row_word_t *word, dog_row_word_t mask, char mode)
+{
+  switch(mode)
+  {
+  case 's': *word |= mask;  break;
+  case 'c': *word &= ~mask; break;
+  default:  *word ^= mask;  break;
+  }
+}
+
+/** This function is used to read byte @a k (columns 8k to 8k+7) of a row.
+ *  With 8-bit words it is a plain load.
+ *
+ *  @par Parameters
+ *    - @a row = The row.
+ *    - @a k   = Index of the byte [0,DOG_ROW_BYTES-1].
+ *
+ *  @returns The byte, the lowest column in bit 0.
+ */
+static uint8_t dog_rows_get_byte(const dog_row_word_t *row, uint8_t k)
+{
+  return (uint8_t)(row[k / DOG_ROW_WORD_BYTES] >>
+                   (8 * (k % DOG_ROW_WORD_BYTES)));
+}
+
+/** This function is used to overwrite byte @a k of a row.
+ *
+ *  @par Parameters
+ *    - @a row  = The row.
+ *    - @a k    = Index of the byte [0,DOG_ROW_BYTES-1].
+ *    - @a byte = The new contents, the lowest column in bit 0.
+ */
+static void dog_rows_put_byte(dog_row_word_t *row, uint8_t k, uint8_t byte)
+{
+  uint8_t shift = 8 * (k % DOG_ROW_WORD_BYTES);
+  dog_row_word_t *word = &row[k / DOG_ROW_WORD_BYTES];
+
+  *word = (dog_row_word_t)((*word & ~((dog_row_word_t)0xFF << shift)) |
+                           ((dog_row_word_t)byte << shift));
+}
+
+/** This function is used to record a changed region.
+ *
+ *  @par Parameters
+ *    - @a x1 = First changed column.
+ *    - @a x2 = Last changed column.
+ *    - @a y1 = First changed row.
+ *    - @a y2 = Last changed row.
+ */
+static void dog_rows_mark(uint8_t x1, uint8_t x2, uint8_t y1, uint8_t y2)
+{
+  uint8_t page;
+
+  for(page = y1 >> 3; page <= (y2 >> 3); ++page)
+  {
+    if(x1 < rows_dirty.first[page]) rows_dirty.first[page] = x1;
+    if(x2 > rows_dirty.last[page])  rows_dirty.last[page] = x2;
+  }
+  DOG_STAT_ADD(buffer_bytes,
+               ((x2 >> 3) - (x1 >> 3) + 1) * (uint16_t)(y2 - y1 + 1));
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int8_t dog_rows_pixel(uint8_t x, uint8_t y, char mode)
+{
+  if(x >= DOG_WIDTH || y >= DOG_HEIGHT) return -1;
+  if(mode != 's' && mode != 'c' && mode != 'x') return -1;
+
+  dog_rows_apply(&dog_rows[y][x / DOG_ROW_WORD_BITS],
+                 (dog_row_word_t)1 << (x % DOG_ROW_WORD_BITS), mode);
+  dog_rows_mark(x, x, y, y);
+  DOG_STAT_ADD(pixels, 1);
+  return 0;
+}
+
+int8_t dog_rows_h_span(uint8_t x1, uint8_t x2, uint8_t y, char mode)
+{
+  dog_row_word_t *row;
+  dog_row_word_t head, tail, fill;
+  uint8_t first, last, k;
+
+  if(x1 > x2)
+  {
+    k = x1;
+    x1 = x2;
+    x2 = k;
+  }
+  if(x2 >= DOG_WIDTH || y >= DOG_HEIGHT) return -1;
+  if(mode != 's' && mode != 'c' && mode != 'x') return -1;
+
+  row = dog_rows[y];
+  first = x1 / DOG_ROW_WORD_BITS;
+  last = x2 / DOG_ROW_WORD_BITS;
+  /* columns x1 and up, and columns up to x2, of their words */
+  head = (dog_row_word_t)(DOG_ROW_ONES << (x1 % DOG_ROW_WORD_BITS));
+  tail = (dog_row_word_t)(DOG_ROW_ONES >>
+                          (DOG_ROW_WORD_BITS - 1 - x2 % DOG_ROW_WORD_BITS));
+
+  if(first == last)
+  {
+    dog_rows_apply(&row[first], head & tail, mode);
+  }
+  else
+  {
+    dog_rows_apply(&row[first], head, mode);
+
+    /* Whole words in between */
+    fill = (mode == 's') ? DOG_ROW_ONES : 0;
+    for(k = first + 1; k < last; ++k)
+    {
+      if(mode == 'x')
+        row[k] = ~row[k];
+      else
+        row[k] = fill;
+    }
+
+    dog_rows_apply(&row[last], tail, mode);
+  }
+
+  dog_rows_mark(x1, x2, y, y);
+  DOG_STAT_ADD(pixels, x2 - x1 + 1);
+  return 0;
+}
+
+int8_t dog_rows_fill_rectangle(uint8_t x, uint8_t y, uint8_t width,
+                               uint8_t height, char mode)
+{
+  uint8_t x2, y2;
+
+  if(x >= DOG_WIDTH || y >= DOG_HEIGHT || !width || !height) return -1;
+
+  x2 = (width > DOG_WIDTH - x) ? DOG_WIDTH - 1 : x + width - 1;
+  y2 = (height > DOG_HEIGHT - y) ? DOG_HEIGHT - 1 : y + height - 1;
+
+  for(; y <= y2; ++y)
+  {
+    if(dog_rows_h_span(x, x2, y, mode) < 0) return -1;
+  }
+  return 0;
+}
+
+int8_t dog_rows_draw_bitmap(uint8_t x, uint8_t y, const uint8_t *bitmap,
+                            uint8_t width, uint8_t height)
+{
+  uint8_t stride, shift, col, row, b, byte, x2, y2;
+  dog_row_word_t *dst;
+
+  if(x >= DOG_WIDTH || y >= DOG_HEIGHT || !width || !height) return -1;
+
+  stride = (width + 7) >> 3;
+  shift = x & 7;
+  col = x >> 3;
+  x2 = (width > DOG_WIDTH - x) ? DOG_WIDTH - 1 : x + width - 1;
+  y2 = (height > DOG_HEIGHT - y) ? DOG_HEIGHT - 1 : y + height - 1;
+
+  for(row = 0; row <= y2 - y; ++row, bitmap += stride)
+  {
+    dst = dog_rows[y + row];
+    for(b = 0; b < stride && col + b < DOG_ROW_BYTES; ++b)
+    {
+      byte = bitmap[b];
+      if(b == stride - 1 && (width & 7))
+        byte &= (uint8_t)(0xFF >> (8 - (width & 7)));  /* Drop the padding */
+
+      /* Each source byte lands in at most two bytes of the row */
+      dog_rows_put_byte(dst, col + b, dog_rows_get_byte(dst, col + b) |
+                                      (uint8_t)(byte << shift));
+      if(shift && col + b + 1 < DOG_ROW_BYTES)
+        dog_rows_put_byte(dst, col + b + 1,
+                          dog_rows_get_byte(dst, col + b + 1) |
+                          (uint8_t)(byte >> (8 - shift)));
+    }
+  }
+
+  dog_rows_mark(x, x2, y, y2);
+  return 0;
+}
+
+void dog_rows_clear(void)
+{
+  dog_row_word_t *p = dog_rows[0];
+  uint16_t n;
+
+  for(n = DOG_HEIGHT * DOG_ROW_WORDS; n; --n) *p++ = 0;
+  dog_rows_mark(0, DOG_WIDTH - 1, 0, DOG_HEIGHT - 1);
+}
+
+void dog_rows_load(void)
+{
+  uint8_t page, k, i;
+  uint8_t strip[8];
+
+  /* The transpose is its own inverse */
+  for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+  {
+    for(k = 0; k < DOG_ROW_BYTES; ++k)
+    {
+      dog_transpose8x8(&dog_main_buffer[page][k * 8], strip);
+      for(i = 0; i < 8; ++i)
+        dog_rows_put_byte(dog_rows[page * 8 + i], k, strip[i]);
+    }
+  }
+  dog_dirty_reset(&rows_dirty);
+}
+
+void dog_rows_invalidate(const dog_span_t *span)
+{
+  dog_rows_mark(span->col_start, span->col_end,
+                span->page_start * DOG_PAGE_HEIGHT,
+                span->page_end * DOG_PAGE_HEIGHT + DOG_PAGE_HEIGHT - 1);
+}
+
+void dog_rows_commit(void)
+{
+  uint8_t page, first, last, k, i;
+  uint8_t strip[8];
+
+  for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+  {
+    if(rows_dirty.first[page] > rows_dirty.last[page]) continue;
+
+    /* Whole 8 x 8 blocks covering the changed columns */
+    first = rows_dirty.first[page] >> 3;
+    last = rows_dirty.last[page] >> 3;
+    for(k = first; k <= last; ++k)
+    {
+      for(i = 0; i < 8; ++i)
+        strip[i] = dog_rows_get_byte(dog_rows[page * 8 + i], k);
+      dog_transpose8x8(strip, &dog_main_buffer[page][k * 8]);
+    }
+
+    if(first * 8 < dog_main_dirty.first[page])
+      dog_main_dirty.first[page] = first * 8;
+    if(last * 8 + 7 > dog_main_dirty.last[page])
+      dog_main_dirty.last[page] = last * 8 + 7;
+  }
+
+  dog_dirty_reset(&rows_dirty);
+}
+
+#endif /* DOG_ROW_MAJOR */
+
+/* @} */ /* DOGM128_rows_source */
@@ -0,0 +1,176 @@
+/**
+ * @file   DOGM128_rows.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Header file for drawing into a row-major working buffer. <br>
+ * @defgroup DOGM128_rows Row-Major Buffer
+ * @{
+ *
+ * This file contains function prototypes for an optional working buffer laid
+ * out row by row, in which each byte holds 8 horizontally adjacent pixels.
+ * The controller, and therefore @b dog_main_buffer, stores 8 vertically
+ * adjacent pixels per byte, so horizontal spans, filled rectangles and
+ * imported bitmaps cost a read-modify-write per pixel column there. In the
+ * row-major buffer the same operations work on whole bytes.
+ *
+ * Drawing into the row-major buffer is followed by dog_rows_commit(), which
+ * converts the changed 8 x 8 blocks into @b dog_main_buffer with
+ * dog_transpose8x8(); the main buffer is then sent as usual, e.g. with
+ * dog_print_buffer() or dog_update_flush(). Which layout suits a workload
+ * best can be measured with the @b DOG_STATS counters.
+ *
+ * The buffer is only built when @b DOG_ROW_MAJOR is set in
+ * DOGM128_user_config.h. It is stored in words of @b DOG_ROW_WORD_BITS bits:
+ * word @a k of row @a y holds columns @b DOG_ROW_WORD_BITS * k upwards, the
+ * lowest column in bit 0, so spans are written a word at a time.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_ROWS_H
+#define DOGM128_ROWS_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Bytes in one row of the row-major buffer */
+#define DOG_ROW_BYTES (DOG_WIDTH / 8)
+/** Bytes in one word of the row-major buffer */
+#define DOG_ROW_WORD_BYTES (DOG_ROW_WORD_BITS / 8)
+/** Words in one row of the row-major buffer */
+#define DOG_ROW_WORDS (DOG_WIDTH / DOG_ROW_WORD_BITS)
+
+#if DOG_ROW_WORD_BITS != 8 && DOG_ROW_WORD_BITS != 16 && \
+    DOG_ROW_WORD_BITS != 32
+#error "DOG_ROW_WORD_BITS must be 8, 16 or 32"
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+/** used to store one word of the row-major buffer */
+#if DOG_ROW_WORD_BITS == 32
+typedef uint32_t dog_row_word_t;
+#elif DOG_ROW_WORD_BITS == 16
+typedef uint16_t dog_row_word_t;
+#else
+typedef uint8_t dog_row_word_t;
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* EXTERNAL DATA                                                              */
+/*----------------------------------------------------------------------------*/
+/** Row-major working buffer. Direct writes must be followed by
+ *  dog_rows_invalidate() so that dog_rows_commit() picks them up.
+ */
+extern dog_row_word_t dog_rows[DOG_HEIGHT][DOG_ROW_WORDS];
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to set, clear or invert one pixel of the row-major
+ *  buffer.
+ *
+ *  @par Parameters
+ *         - @a x    = X coordinate of the pixel [0,127].
+ *         - @a y    = Y coordinate of the pixel [0,63].
+ *         - @a mode = 's' to set, 'c' to clear or 'x' to invert the pixel.
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise it
+ *           returns -1.
+ */
+int8_t dog_rows_pixel(uint8_t x, uint8_t y, char mode);
+
+/** This function is used to set, clear or invert a horizontal span of pixels
+ *  of the row-major buffer.
+ *
+ *  @par Parameters
+ *         - @a x1   = X coordinate of one end of the span [0,127].
+ *         - @a x2   = X coordinate of the other end of the span [0,127].
+ *         - @a y    = Y coordinate of the span [0,63].
+ *         - @a mode = 's' to set, 'c' to clear or 'x' to invert the pixels.
+ *
+ *  @par Algorithm
+ *       The partial words at either end are modified through a mask; the
+ *       words in between are written whole.
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise it
+ *           returns -1.
+ */
+int8_t dog_rows_h_span(uint8_t x1, uint8_t x2, uint8_t y, char mode);
+
+/** This function is used to set, clear or invert a filled rectangle of the
+ *  row-major buffer.
+ *
+ *  @par Parameters
+ *         - @a x      = X coordinate of the top-left corner [0,127].
+ *         - @a y      = Y coordinate of the top-left corner [0,63].
+ *         - @a width  = Width of the rectangle in pixels; clipped at the edge.
+ *         - @a height = Height of the rectangle in pixels; clipped at the edge.
+ *         - @a mode   = 's' to set, 'c' to clear or 'x' to invert the pixels.
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise it
+ *           returns -1.
+ */
+int8_t dog_rows_fill_rectangle(uint8_t x, uint8_t y, uint8_t width,
+                               uint8_t height, char mode);
+
+/** This function is used to OR a bitmap into the row-major buffer.
+ *
+ *  @par Parameters
+ *         - @a x      = X coordinate of the top-left corner [0,127].
+ *         - @a y      = Y coordinate of the top-left corner [0,63].
+ *         - @a bitmap = The bitmap, row by row, each row padded to whole bytes
+ *                       and the leftmost pixel of each byte in bit 0.
+ *         - @a width  = Width of the bitmap in pixels.
+ *         - @a height = Height of the bitmap in pixels.
+ *
+ *  @par Algorithm
+ *       Each byte of the bitmap is shifted into place and ORed into at most
+ *       two bytes of the buffer. Pixels beyond the edge are clipped.
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise it
+ *           returns -1.
+ */
+int8_t dog_rows_draw_bitmap(uint8_t x, uint8_t y, const uint8_t *bitmap,
+                            uint8_t width, uint8_t height);
+
+/** This function is used to clear the row-major buffer. */
+void dog_rows_clear(void);
+
+/** This function is used to copy @b dog_main_buffer into the row-major
+ *  buffer, e.g. to continue drawing on an image made with the other
+ *  functions of the library.
+ */
+void dog_rows_load(void);
+
+/** This function is used to mark a region of the row-major buffer as changed
+ *  after writing to @b dog_rows directly.
+ *
+ *  @par Parameters
+ *         - @a span = The changed region, in pages and columns.
+ */
+void dog_rows_invalidate(const dog_span_t *span);
+
+/** This function is used to convert the changed parts of the row-major buffer
+ *  into @b dog_main_buffer.
+ *
+ *  @par Algorithm
+ *       For every page, the 8 x 8 blocks between the first and last changed
+ *       column are gathered from 8 rows and transposed with
+ *       dog_transpose8x8() straight into the main buffer, whose dirty region
+ *       is extended to match.
+ *
+ *  @par Assumptions
+ *       - The orientation is one of the landscape modes.
+ */
+void dog_rows_commit(void);
+
+#endif /* DOGM128_ROWS_H */
+/** @} */ /* DOGM128_rows */
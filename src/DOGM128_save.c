@@ -0,0 +1,83 @@
+/*
+ * @file   DOGM128_save.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for save-under buffers of the EA DOGM128. <br>
+ * @defgroup DOGM128_save_source
+ * @{
+ *
+ * This file contains the source code for the functions described in
+ * save.h. The user should include this file in his or her project should
+ * they choose to save and restore parts of the buffer.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <string.h>
+#include "DOGM128_save.h"
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+uint16_t dog_save_span(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2,
+                       dog_span_t *span)
+{
+  span->page_start = y1 >> 3;
+  span->page_end = y2 >> 3;
+  span->col_start = x1;
+  span->col_end = x2;
+  return DOG_SAVE_BYTES(span->page_end - span->page_start + 1, x2 - x1 + 1);
+}
+
+int8_t dog_save_under(dog_save_t *save,
+                      const dog_span_t *span,
+                      uint8_t *data,
+                      uint16_t size)
+{
+  uint8_t page, width;
+  uint8_t *dst = data;
+
+  if(span->page_start > span->page_end || span->page_end >= DOG_PAGE_HEIGHT)
+    return -1;
+  if(span->col_start > span->col_end || span->col_end >= DOG_WIDTH) return -1;
+
+  width = span->col_end - span->col_start + 1;
+  if(DOG_SAVE_BYTES(span->page_end - span->page_start + 1, width) > size)
+    return -1;
+
+  for(page = span->page_start; page <= span->page_end; ++page, dst += width)
+    memcpy(dst, &dog_buffer[page][span->col_start], width);
+
+  save->span = *span;
+  save->data = data;
+  save->saved = 1;
+  return 0;
+}
+
+int8_t dog_restore_under(dog_save_t *save)
+{
+  const uint8_t *src;
+  uint8_t page, width;
+
+  if(!save->saved) return -1;
+
+  src = save->data;
+  width = save->span.col_end - save->span.col_start + 1;
+  for(page = save->span.page_start; page <= save->span.page_end;
+      ++page, src += width)
+  {
+    memcpy(&dog_buffer[page][save->span.col_start], src, width);
+    DOG_MARK_DIRTY(page, save->span.col_start);
+    DOG_MARK_DIRTY(page, save->span.col_end);
+  }
+
+  DOG_STAT_ADD(buffer_bytes, (uint16_t)width *
+               (save->span.page_end - save->span.page_start + 1));
+  save->saved = 0;
+  return 0;
+}
+
+/* @} */ /* DOGM128_save_source */
@@ -0,0 +1,106 @@
+/**
+ * @file   DOGM128_save.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Header file for save-under buffers of the EA DOGM128. <br>
+ * @defgroup DOGM128_save Save-Under Buffers
+ * @{
+ *
+ * This file contains function prototypes for saving the part of the buffer
+ * a popup or menu is about to cover, and putting it back when the popup
+ * closes, so that the scene underneath need not be drawn again.
+ *
+ * The part saved is a span of whole pages and columns of @b dog_buffer,
+ * stored in memory supplied by the caller, which needs
+ * @b DOG_SAVE_BYTES(pages, columns) bytes. Saving and restoring are one
+ * memcpy() per page each; the restored span is marked dirty.
+ *
+ * Since whole pages are saved, anything drawn into the saved span while the
+ * popup is open, also beside it on the same pages, is undone by the
+ * restore.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_SAVE_H
+#define DOGM128_SAVE_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Bytes of storage needed to save a span of @a pages pages by @a columns
+ *  columns, e.g. to size a static array */
+#define DOG_SAVE_BYTES(pages, columns) ((uint16_t)(pages) * (columns))
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** used to hold a saved part of the buffer */
+typedef struct
+{
+  dog_span_t span;          /**< pages and columns saved                 */
+  uint8_t *data;            /**< the saved bytes, page by page           */
+  uint8_t saved;            /**< non-zero while @a data holds a save     */
+} dog_save_t;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to find the pages and columns which cover a
+ *  rectangle of pixels.
+ *
+ *  @par Parameters
+ *         - @a x1   = Left-hand column of the rectangle [0,127].
+ *         - @a y1   = Top row of the rectangle [0,63].
+ *         - @a x2   = Right-hand column of the rectangle [x1,127].
+ *         - @a y2   = Bottom row of the rectangle [y1,63].
+ *         - @a span = Receives the pages and columns.
+ *
+ *  @returns The number of bytes needed to save the span.
+ */
+uint16_t dog_save_span(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2,
+                       dog_span_t *span);
+
+/** This function is used to save a span of @b dog_buffer.
+ *
+ *  @par Parameters
+ *         - @a save = Receives the saved span.
+ *         - @a span = The pages and columns to be saved.
+ *         - @a data = Storage for the saved bytes.
+ *         - @a size = Size of @a data in bytes.
+ *
+ *  @par Assumptions
+ *       - The orientation is one of the landscape modes.
+ *       - @a data stays valid until the span is restored.
+ *
+ *  @returns Upon successful completion, the function returns zero. It returns
+ *           -1 if the span is invalid or @a data is too small.
+ */
+int8_t dog_save_under(dog_save_t *save,
+                      const dog_span_t *span,
+                      uint8_t *data,
+                      uint16_t size);
+
+/** This function is used to put a saved span back into @b dog_buffer and
+ *  mark it dirty. The save is used up.
+ *
+ *  @par Parameters
+ *         - @a save = The saved span.
+ *
+ *  @par Assumptions
+ *       - The draw target is the one the span was saved from.
+ *
+ *  @returns Upon successful completion, the function returns zero. It returns
+ *           -1 if nothing is saved.
+ */
+int8_t dog_restore_under(dog_save_t *save);
+
+#endif /* DOGM128_SAVE_H */
+/** @} */ /* DOGM128_save */
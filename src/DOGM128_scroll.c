@@ -0,0 +1,183 @@
+/*
+ * @file   DOGM128_scroll.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for scrolling regions of the EA DOGM128 buffer. <br>
+ * @defgroup DOGM128_scroll_source
+ * @{
+ *
+ * This file contains the source code for the functions described in
+ * scroll.h. The user should include this file, along with rectangle.c, in
+ * his or her project should they choose to scroll regions of the buffer.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <string.h>
+#include "DOGM128_scroll.h"
+#include "DOGM128_rectangle.h"
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to find the rows of a region within a page.
+ *
+ *  @par Parameters
+ *    - @a page = The page.
+ *    - @a y1   = Top row of the region.
+ *    - @a y2   = Bottom row of the region.
+ *
+ *  @returns A mask of the rows of the page which lie within the region.
+ */
+static uint8_t dog_scroll_mask(uint8_t page, uint8_t y1, uint8_t y2)
+{
+  uint8_t mask = 0xFF;
+
+  if(page == (y1 >> 3)) mask &= (uint8_t)(0xFF << (y1 & 7));
+  if(page == (y2 >> 3)) mask &= (uint8_t)(0xFF >> (7 - (y2 & 7)));
+  return mask;
+}
+
+/** This function is used to check the parameters of a scroll and mark the
+ *  region dirty.
+ *
+ *  @par Parameters
+ *    - @a x1, @a y1, @a x2, @a y2 = The region.
+ *    - @a fill = The fill mode.
+ *
+ *  @returns 0 if the parameters are valid, -1 otherwise.
+ */
+static int8_t dog_scroll_begin(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2,
+                               char fill)
+{
+  uint8_t page;
+
+  if(x1 > x2 || y1 > y2 || x2 >= DOG_WIDTH || y2 >= DOG_HEIGHT) return -1;
+  if(dog_orientation >= DOG_ORIENT_90) return -1;
+  if(fill != 's' && fill != 'c') return -1;
+
+  for(page = y1 >> 3; page <= (y2 >> 3); ++page)
+  {
+    DOG_MARK_DIRTY(page, x1);
+    DOG_MARK_DIRTY(page, x2);
+  }
+  DOG_STAT_ADD(buffer_bytes,
+               (uint16_t)(x2 - x1 + 1) * ((y2 >> 3) - (y1 >> 3) + 1));
+  return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int8_t dog_scroll_h(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2,
+                    int8_t n, char fill)
+{
+  uint8_t page, mask, count, shift, i;
+  uint8_t *dst;
+  const uint8_t *src;
+
+  if(dog_scroll_begin(x1, y1, x2, y2, fill) < 0) return -1;
+  if(n == 0) return 0;
+
+  shift = (n > 0) ? n : -n;
+  if(shift > x2 - x1)                 /* Everything moves out of the region */
+    return dog_fill_rectangle(x1, y1, x2, y2, fill);
+  count = x2 - x1 + 1 - shift;
+
+  for(page = y1 >> 3; page <= (y2 >> 3); ++page)
+  {
+    mask = dog_scroll_mask(page, y1, y2);
+    dst = &dog_buffer[page][(n > 0) ? x1 + shift : x1];
+    src = &dog_buffer[page][(n > 0) ? x1 : x1 + shift];
+
+    if(mask == 0xFF)
+    {
+      memmove(dst, src, count);
+    }
+    else if(n < 0)
+    {
+      /* Moving left, so every byte is read before it is overwritten */
+      for(i = 0; i < count; ++i)
+        dst[i] = (dst[i] & ~mask) | (src[i] & mask);
+    }
+    else
+    {
+      /* Moving right; work backwards for the same reason */
+      for(i = count; i; --i)
+        dst[i - 1] = (dst[i - 1] & ~mask) | (src[i - 1] & mask);
+    }
+  }
+
+  /* Fill the columns left behind */
+  if(n > 0)
+    return dog_fill_rectangle(x1, y1, x1 + shift - 1, y2, fill);
+  return dog_fill_rectangle(x2 - shift + 1, y1, x2, y2, fill);
+}
+
+int8_t dog_scroll_v(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2,
+                    int8_t n, char fill)
+{
+  uint8_t column[DOG_PAGE_HEIGHT + 2];
+  uint8_t col, page, shift, pages, bits, moved, mask;
+  int8_t from;
+
+  if(dog_scroll_begin(x1, y1, x2, y2, fill) < 0) return -1;
+  if(n == 0) return 0;
+
+  shift = (n > 0) ? n : -n;
+  if(shift > y2 - y1)                 /* Everything moves out of the region */
+    return dog_fill_rectangle(x1, y1, x2, y2, fill);
+
+  pages = shift >> 3;
+  bits = shift & 7;
+
+  /* column[p + 1] holds page p, with an empty page on either side */
+  column[0] = 0;
+  column[DOG_PAGE_HEIGHT + 1] = 0;
+
+  for(col = x1; col <= x2; ++col)
+  {
+    for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+      column[page + 1] = dog_buffer[page][col];
+
+    for(page = y1 >> 3; page <= (y2 >> 3); ++page)
+    {
+      if(n > 0)
+      {
+        /* Row r takes row r - shift: a page above, bits towards bit 7 */
+        from = page - pages;
+        moved = 0;
+        if(from >= 0)
+        {
+          moved = (uint8_t)(column[from + 1] << bits);
+          if(bits) moved |= column[from] >> (8 - bits);
+        }
+      }
+      else
+      {
+        /* Row r takes row r + shift: a page below, bits towards bit 0 */
+        from = page + pages;
+        moved = 0;
+        if(from < DOG_PAGE_HEIGHT)
+        {
+          moved = column[from + 1] >> bits;
+          if(bits) moved |= (uint8_t)(column[from + 2] << (8 - bits));
+        }
+      }
+
+      mask = dog_scroll_mask(page, y1, y2);
+      dog_buffer[page][col] = (dog_buffer[page][col] & ~mask) | (moved & mask);
+    }
+  }
+
+  /* Fill the rows left behind */
+  if(n > 0)
+    return dog_fill_rectangle(x1, y1, x2, y1 + shift - 1, fill);
+  return dog_fill_rectangle(x1, y2 - shift + 1, x2, y2, fill);
+}
+
+/* @} */ /* DOGM128_scroll_source */
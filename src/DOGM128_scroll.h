@@ -0,0 +1,88 @@
+/**
+ * @file   DOGM128_scroll.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Header file for scrolling regions of the EA DOGM128 buffer. <br>
+ * @defgroup DOGM128_scroll Region Scrolling
+ * @{
+ *
+ * This file contains function prototypes for moving the contents of a
+ * rectangular region of the buffer, left or right by a number of columns or
+ * up or down by a number of rows. Content moved out of the region is lost,
+ * the area it exposes is filled, and everything outside the region is left
+ * alone. Only the region is marked dirty.
+ *
+ * The display can only scroll the whole screen vertically (by its start
+ * line); these functions work on the buffer and so cover tickers, marquee
+ * text and list scrolling, without drawing the content again.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_SCROLL_H
+#define DOGM128_SCROLL_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to move the contents of a region left or right.
+ *
+ *  @par Parameters
+ *         - @a x1   = Left-hand column of the region [0,127].
+ *         - @a y1   = Top row of the region [0,63].
+ *         - @a x2   = Right-hand column of the region [x1,127].
+ *         - @a y2   = Bottom row of the region [y1,63].
+ *         - @a n    = Columns to move by; positive moves right, negative
+ *                     moves left.
+ *         - @a fill = 's' to set or 'c' to clear the exposed columns.
+ *
+ *  @par Algorithm
+ *       Pages the region covers completely are moved with a single memmove()
+ *       each. On a page the region only partly covers, the bytes are moved
+ *       one at a time through a mask of the rows of the region. The exposed
+ *       columns are then filled with dog_fill_rectangle().
+ *
+ *  @par Assumptions
+ *       - The orientation is one of the landscape modes.
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise it
+ *           returns -1.
+ */
+int8_t dog_scroll_h(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2,
+                    int8_t n, char fill);
+
+/** This function is used to move the contents of a region up or down.
+ *
+ *  @par Parameters
+ *         - @a x1   = Left-hand column of the region [0,127].
+ *         - @a y1   = Top row of the region [0,63].
+ *         - @a x2   = Right-hand column of the region [x1,127].
+ *         - @a y2   = Bottom row of the region [y1,63].
+ *         - @a n    = Rows to move by; positive moves down, negative moves
+ *                     up.
+ *         - @a fill = 's' to set or 'c' to clear the exposed rows.
+ *
+ *  @par Algorithm
+ *       A move by @a n rows is a move by n / 8 whole pages combined with a
+ *       shift by n % 8 bits, the bits shifted out of one page carrying into
+ *       the next. Each column of the region is gathered from the pages it
+ *       spans, shifted and written back through the row masks of the region.
+ *       The exposed rows are then filled with dog_fill_rectangle().
+ *
+ *  @par Assumptions
+ *       - The orientation is one of the landscape modes.
+ *
+ *  @returns Upon successful completion, the function returns zero. Otherwise it
+ *           returns -1.
+ */
+int8_t dog_scroll_v(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2,
+                    int8_t n, char fill);
+
+#endif /* DOGM128_SCROLL_H */
+/** @} */ /* DOGM128_scroll */
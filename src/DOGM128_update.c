@@ -0,0 +1,331 @@
+/*
+ * @file   DOGM128_update.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for incremental updates of the EA DOGM128. <br>
+ * @defgroup DOGM128_update_source
+ * @{
+ *
+ * This file contains the source code for the functions described in
+ * update.h. The user should include this file in his or her project
+ * should they choose to send only the changed parts of the buffer. Note that
+ * it holds a 1 KB shadow copy of the display RAM.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <string.h>
+#include "DOGM128_update.h"
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static uint8_t shadow[DOG_PAGE_HEIGHT][DOG_WIDTH]
+ * @brief Copy of what was last sent to the display RAM. dog_init() clears the
+ *        display, so the zero-initialized shadow is correct from the start.
+ *
+ * @var static uint8_t shadow_valid
+ * @brief Cleared by dog_update_invalidate() when the shadow cannot be trusted.
+ *
+ * @var static dog_change_set_t changes
+ * @brief Runs of changed bytes found by the last dog_update_flush().
+ *
+ * @var static dog_plan_t plan
+ * @brief Plan sent by the last dog_update_flush(); kept for its statistics.
+ */
+static uint8_t shadow[DOG_PAGE_HEIGHT][DOG_WIDTH];
+static uint8_t shadow_valid = 1;
+static dog_change_set_t changes;
+static dog_plan_t plan;
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to find the first column within a range at which a
+ *  page of the buffer and the shadow differ.
+ *
+ *  @par Parameters
+ *    - @a a   = A page of the buffer.
+ *    - @a b   = The same page of the shadow.
+ *    - @a col = The column to start searching from.
+ *    - @a end = The last column to search.
+ *
+ *  @returns The first differing column, or @a end + 1 if there is none.
+ */
+static uint8_t dog_find_change(const uint8_t *a, const uint8_t *b, uint8_t col,
+                               uint8_t end)
+{
+#if DOG_UPDATE_WORD_COMPARE
+  unsigned long wa, wb;
+
+  /* Skip over identical words; memcpy keeps the loads alignment-safe */
+  while(col + sizeof(wa) <= end + 1u)
+  {
+    memcpy(&wa, a + col, sizeof(wa));
+    memcpy(&wb, b + col, sizeof(wb));
+    if(wa != wb) break;
+    col += sizeof(wa);
+  }
+#endif /* DOG_UPDATE_WORD_COMPARE */
+
+  while(col <= end && a[col] == b[col]) ++col;
+  return col;
+}
+
+/** This function is used to work out which column address commands are
+ *  needed to move the column address of the display.
+ *
+ *  @par Parameters
+ *    - @a known   = 0 if the current column address is unknown.
+ *    - @a current = The current column address.
+ *    - @a target  = The column address to move to.
+ *
+ *  @returns A combination of @b DOG_SEEK_COL_HI and @b DOG_SEEK_COL_LO.
+ */
+static uint8_t dog_column_seek(uint8_t known, uint8_t current, uint8_t target)
+{
+  /* The nibbles that matter are those of the addresses actually sent */
+  current += dog_column_offset;
+  target += dog_column_offset;
+
+  if(known && current == target) return 0;
+  if(known && (current >> 4) == (target >> 4)) return DOG_SEEK_COL_LO;
+  return DOG_SEEK_COL_HI | DOG_SEEK_COL_LO;
+}
+
+/** This function is used to count the command bytes of a segment.
+ *
+ *  @par Parameters
+ *    - @a commands = A combination of DOG_SEEK_* flags.
+ *
+ *  @returns The number of command bytes.
+ */
+static uint8_t dog_command_bytes(uint8_t commands)
+{
+  return (commands & 1) + ((commands >> 1) & 1) + ((commands >> 2) & 1);
+}
+
+/** This function is used to append a segment to a plan and account for its
+ *  cost.
+ *
+ *  @par Parameters
+ *    - @a plan    = The plan being built.
+ *    - @a segment = The segment to be appended.
+ */
+static void dog_plan_emit(dog_plan_t *plan, const dog_segment_t *segment)
+{
+  plan->segments[plan->count++] = *segment;
+  plan->stats.seeks++;
+  plan->stats.command_bytes += dog_command_bytes(segment->commands);
+  plan->stats.data_bytes += segment->last - segment->first + 1;
+  plan->stats.a0_toggles += 2;                  /* to command, back to data */
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+void dog_plan_build(const dog_change_set_t *changes, dog_plan_t *plan)
+{
+  dog_segment_t segment;
+  const dog_run_t *run;
+  uint8_t done[DOG_PAGE_HEIGHT];
+  uint8_t page, best, cost, best_cost, r, gap, skip;
+  uint8_t known = 0, column = 0;
+
+  plan->count = 0;
+  plan->stats.data_bytes = 0;
+  plan->stats.bridged_bytes = 0;
+  plan->stats.command_bytes = 0;
+  plan->stats.a0_toggles = 0;
+  plan->stats.seeks = 0;
+  plan->stats.full_page_bytes = 0;
+  plan->stats.per_run_bytes = 0;
+
+  /* Cost of the simple strategies, for comparison */
+  for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+  {
+    done[page] = (changes->count[page] == 0);
+    if(done[page]) continue;
+    plan->stats.full_page_bytes += 3 + DOG_WIDTH;
+    for(r = 0; r < changes->count[page]; ++r)
+    {
+      run = &changes->runs[page][r];
+      plan->stats.per_run_bytes += 3 + run->last - run->first + 1;
+    }
+  }
+
+  for(;;)
+  {
+    /* Pick the page whose first run is cheapest to reach */
+    best = DOG_PAGE_HEIGHT;
+    best_cost = 0xFF;
+    for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+    {
+      if(done[page]) continue;
+      cost = dog_command_bytes(dog_column_seek(known, column,
+                                               changes->runs[page][0].first));
+      if(cost < best_cost)
+      {
+        best = page;
+        best_cost = cost;
+      }
+    }
+    if(best == DOG_PAGE_HEIGHT) break;                  /* All pages done */
+    done[best] = 1;
+
+    run = changes->runs[best];
+    segment.page = best;
+    segment.first = run->first;
+    segment.last = run->last;
+    segment.commands = DOG_SEEK_PAGE | dog_column_seek(known, column, 
+                                                       run->first);
+
+    /* Bridge gaps which are cheaper to send than to skip */
+    for(r = 1; r < changes->count[best]; ++r)
+    {
+      ++run;
+      gap = run->first - segment.last - 1;
+      skip = dog_column_seek(1, segment.last + 1, run->first);
+      if(gap <= dog_command_bytes(skip) + 2*DOG_A0_TOGGLE_COST)
+      {
+        plan->stats.bridged_bytes += gap;
+        segment.last = run->last;
+      }
+      else
+      {
+        dog_plan_emit(plan, &segment);
+        segment.first = run->first;
+        segment.last = run->last;
+        segment.commands = skip;
+      }
+    }
+    dog_plan_emit(plan, &segment);
+
+    /* The column address is left just past the last byte written */
+    known = 1;
+    column = segment.last + 1;
+  }
+}
+
+void dog_plan_execute(const dog_plan_t *plan,
+                      uint8_t (*src)[DOG_WIDTH],
+                      uint8_t (*copy)[DOG_WIDTH])
+{
+  const dog_segment_t *segment = plan->segments;
+  const uint8_t *data;
+  uint8_t *dst;
+  uint8_t i, col;
+
+  DOG_SLAVE_SELECT();
+
+  for(i = 0; i < plan->count; ++i, ++segment)
+  {
+    DOG_SEND_COMMAND();              /* Ready display to receive commands */
+    if(segment->commands & DOG_SEEK_PAGE)
+    {
+      DOG_SPI_TRANSMIT(0xB0 | segment->page);
+    }
+    col = segment->first + dog_column_offset;
+    if(segment->commands & DOG_SEEK_COL_HI)
+    {
+      DOG_SPI_TRANSMIT(0x10 | (col >> 4));
+    }
+    if(segment->commands & DOG_SEEK_COL_LO)
+    {
+      DOG_SPI_TRANSMIT(col & 0x0F);
+    }
+
+    data = src[segment->page];
+    dog_spi_send_data(data + segment->first, 
+                      segment->last - segment->first + 1);
+
+    if(copy)
+    {
+      dst = copy[segment->page];
+      for(col = segment->first; col <= segment->last; ++col)
+        dst[col] = data[col];
+    }
+  }
+
+  DOG_SLAVE_DESELECT();
+}
+
+uint16_t dog_update_flush_region(const dog_dirty_t *region)
+{
+  uint8_t page, first, last, end;
+  uint8_t *src, *dst;
+  uint16_t n;
+
+  DOG_STAT_FLUSH_BEGIN();
+
+  if(!shadow_valid)
+  {
+    /* Force every byte to differ by making the shadow the inverse */
+    src = dog_main_buffer[0];
+    dst = shadow[0];
+    for(n = DOG_PAGE_HEIGHT * DOG_WIDTH; n; --n) *dst++ = ~*src++;
+    shadow_valid = 1;
+  }
+
+  /* Collect the runs of changed bytes within the region on each page */
+  for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+  {
+    src = dog_main_buffer[page];
+    dst = shadow[page];
+    changes.count[page] = 0;
+    if(region->first[page] > region->last[page]) continue;
+    end = region->last[page];
+
+    first = dog_find_change(src, dst, region->first[page], end);
+    while(first <= end)
+    {
+      last = first;
+      while(last < end && src[last + 1] != dst[last + 1]) ++last;
+
+      if(changes.count[page] < DOG_PLAN_MAX_RUNS)
+      {
+        changes.runs[page][changes.count[page]].first = first;
+        changes.runs[page][changes.count[page]].last = last;
+        ++changes.count[page];
+      }
+      else          /* Out of runs; stretch the last one over this change */
+        changes.runs[page][DOG_PLAN_MAX_RUNS - 1].last = last;
+
+      if(last == end) break;
+      first = dog_find_change(src, dst, last + 1, end);
+    }
+  }
+
+  dog_plan_build(&changes, &plan);
+  dog_plan_execute(&plan, dog_main_buffer, shadow);
+
+  DOG_STAT_FLUSH_END();
+  return plan.stats.data_bytes;
+}
+
+uint16_t dog_update_flush(void)
+{
+  static const dog_dirty_t everything = DOG_DIRTY_ALL;
+  uint16_t bytes;
+
+  bytes = dog_update_flush_region(&everything);
+  dog_dirty_reset(&dog_main_dirty);
+  return bytes;
+}
+
+void dog_update_invalidate(void)
+{
+  shadow_valid = 0;
+}
+
+const dog_plan_stats_t *dog_update_stats(void)
+{
+  return &plan.stats;
+}
+
+/* @} */ /* DOGM128_update_source */
@@ -0,0 +1,193 @@
+/**
+ * @file   DOGM128_update.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Header file for incremental updates of the EA DOGM128. <br>
+ * @defgroup DOGM128_update Incremental Updates
+ * @{
+ *
+ * This file contains function prototypes for sending only the parts of the
+ * main buffer which differ from what the display currently shows. A shadow
+ * copy of the display RAM is kept for this purpose, so the application may
+ * redraw its whole scene every frame and still only pay for the bytes which
+ * actually changed.
+ *
+ * The changed bytes are sent according to a plan which weighs the cost of
+ * moving the display's write position against the cost of resending
+ * unchanged bytes. Moving the write position takes up to three command
+ * bytes: the page address (0xB0 | page) and the upper (0x10 | col >> 4) and
+ * lower (col & 0x0F) column address. The ST7565R controller remembers the
+ * column address across a page change and increments it after every data
+ * byte, so the planner leaves out whichever column commands are not needed
+ * and orders the pages so that as few as possible are needed.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_UPDATE_H
+#define DOGM128_UPDATE_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Maximum number of segments in a plan */
+#define DOG_PLAN_MAX_SEGMENTS (DOG_PAGE_HEIGHT * DOG_PLAN_MAX_RUNS)
+
+/** Segment command flag: send the page address */
+#define DOG_SEEK_PAGE    0x01
+/** Segment command flag: send the upper column address */
+#define DOG_SEEK_COL_HI  0x02
+/** Segment command flag: send the lower column address */
+#define DOG_SEEK_COL_LO  0x04
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** used to describe a run of changed bytes within a page (inclusive) */
+typedef struct
+{
+  uint8_t first;                        /**< first column of the run */
+  uint8_t last;                         /**< last column of the run  */
+} dog_run_t;
+
+/** used to describe every change to be sent, as runs per page. Runs must be
+ *  sorted and must not overlap.
+ */
+typedef struct
+{
+  uint8_t count[DOG_PAGE_HEIGHT];                    /**< runs per page */
+  dog_run_t runs[DOG_PAGE_HEIGHT][DOG_PLAN_MAX_RUNS];/**< the runs      */
+} dog_change_set_t;
+
+/** used to describe one write of a plan: the address commands to send,
+ *  followed by the data of one run of columns.
+ */
+typedef struct
+{
+  uint8_t page;                         /**< page of the run              */
+  uint8_t first;                        /**< first column of the run      */
+  uint8_t last;                         /**< last column of the run       */
+  uint8_t commands;                     /**< DOG_SEEK_* flags             */
+} dog_segment_t;
+
+/** used to report the cost of a plan, and what simpler strategies would
+ *  have cost, in bytes sent over SPI.
+ */
+typedef struct
+{
+  uint16_t data_bytes;       /**< data bytes sent, including bridged gaps  */
+  uint16_t bridged_bytes;    /**< unchanged bytes sent to avoid a reseek   */
+  uint16_t command_bytes;    /**< address command bytes sent               */
+  uint16_t a0_toggles;       /**< switches between command and data mode   */
+  uint16_t seeks;            /**< segments, i.e. moves of the position     */
+  uint16_t full_page_bytes;  /**< cost of resending each changed page     */
+  uint16_t per_run_bytes;    /**< cost of a full reseek for every run      */
+} dog_plan_stats_t;
+
+/** used to hold an ordered list of segments to be sent */
+typedef struct
+{
+  uint8_t count;                                  /**< segments in use  */
+  dog_segment_t segments[DOG_PLAN_MAX_SEGMENTS];  /**< in sending order */
+  dog_plan_stats_t stats;                         /**< cost of the plan */
+} dog_plan_t;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to work out the cheapest way of sending a set of
+ *  changes to the display.
+ *
+ *  @par Parameters
+ *         - @a changes = The runs of changed bytes on each page.
+ *         - @a plan    = Receives the segments to send and their cost.
+ *
+ *  @par Algorithm
+ *       Pages are visited greedily: the next page is the one whose first run
+ *       needs the fewest column address commands given where the previous
+ *       page left the column address. Within a page, the gap between two
+ *       runs is sent as data when that costs no more than the column
+ *       address commands (plus @b DOG_A0_TOGGLE_COST for each of the two A0
+ *       switches) it would take to skip it.
+ *
+ *  @par Assumptions
+ *       - The column address of the display is unknown when the plan starts.
+ */
+void dog_plan_build(const dog_change_set_t *changes, dog_plan_t *plan);
+
+/** This function is used to send a plan to the display.
+ *
+ *  @par Parameters
+ *         - @a plan = The plan to be sent.
+ *         - @a src  = The buffer holding the data to be sent.
+ *         - @a copy = Optional (may be NULL). Every byte sent is also copied
+ *                     into this buffer.
+ *
+ *  @par Assumptions
+ *       - The user has called the dog_init() function.
+ */
+void dog_plan_execute(const dog_plan_t *plan,
+                      uint8_t (*src)[DOG_WIDTH],
+                      uint8_t (*copy)[DOG_WIDTH]);
+
+/** This function is used to send the parts of @b dog_main_buffer which differ
+ *  from the display contents.
+ *
+ *  @par Algorithm
+ *       Each page of the main buffer is compared with the shadow copy of the
+ *       display RAM (a word at a time when @b DOG_UPDATE_WORD_COMPARE is set)
+ *       to find the runs of changed bytes. The runs are handed to
+ *       dog_plan_build() and the resulting plan is sent, updating the shadow
+ *       as it goes. Finally, the main buffer is marked clean.
+ *
+ *  @par Assumptions
+ *       - The user has called the dog_init() function.
+ *       - The display has not been written to other than through this
+ *         function since dog_init(). Otherwise, dog_update_invalidate() must
+ *         be called first.
+ *
+ *  @returns The number of data bytes sent to the display.
+ */
+uint16_t dog_update_flush(void);
+
+/** This function is used to send the parts of a region of @b dog_main_buffer
+ *  which differ from the display contents, leaving the rest for later.
+ *
+ *  @par Parameters
+ *         - @a region = The columns of each page to be compared and sent.
+ *
+ *  @par Algorithm
+ *       As dog_update_flush(), but only the columns within the region are
+ *       compared with the shadow copy. The dirty region of the main buffer
+ *       is left alone.
+ *
+ *  @par Assumptions
+ *       - As for dog_update_flush().
+ *
+ *  @returns The number of data bytes sent to the display.
+ */
+uint16_t dog_update_flush_region(const dog_dirty_t *region);
+
+/** This function is used to tell the incremental update that the display
+ *  contents are unknown, so that the next dog_update_flush() sends the whole
+ *  buffer. Call it after writing to the display by any other means, such as
+ *  dog_print_buffer() or dog_layer_flush().
+ */
+void dog_update_invalidate(void);
+
+/** This function is used to obtain the cost of the last dog_update_flush(),
+ *  along with what a full-page or a per-run flush would have cost.
+ *
+ *  @returns A pointer to the statistics of the last plan sent.
+ */
+const dog_plan_stats_t *dog_update_stats(void);
+
+#endif /* DOGM128_UPDATE_H */
+/** @} */ /* DOGM128_update */
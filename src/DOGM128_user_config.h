@@ -17,6 +17,34 @@
  *
  */
 
+/*----------------------------------------------------------------------------*/
+/* Transport Settings                                                         */
+/*----------------------------------------------------------------------------*/
+/** Transport: the MCU's SPI peripheral */
+#define DOG_TRANSPORT_SPI        0
+/** Transport: SCK and MOSI driven as plain port pins in software */
+#define DOG_TRANSPORT_BITBANG    1
+/** Transport: /dev/spidev and a GPIO character device on Linux; see 
+ *  DOGM128_linux.h
+ */
+#define DOG_TRANSPORT_LINUX      2
+
+/** Transport used to talk to the DOG module. Select 
+ *  @b DOG_TRANSPORT_BITBANG when the SPI peripheral is taken by another 
+ *  device; SCK and MOSI may then be any pins of the MCU.
+ */
+#ifndef DOG_TRANSPORT
+#define DOG_TRANSPORT            DOG_TRANSPORT_SPI
+#endif
+
+/** Set to 1 to take the fixed width integer types from <stdint.h> instead 
+ *  of the library's own typedefs, which assume a 16-bit int. Required when 
+ *  building for a host such as Linux.
+ */
+#ifndef DOG_USE_STDINT
+#define DOG_USE_STDINT           (DOG_TRANSPORT == DOG_TRANSPORT_LINUX)
+#endif
+
 /** include file for the ATMega128. Can be replaced with 
  * another header file when porting to another MCU or
  * compiler.
@@ -25,7 +53,9 @@
 /*----------------------------------------------------------------------------*/
 /* INCLUDES                                                                   */
 /*----------------------------------------------------------------------------*/
+#if DOG_TRANSPORT != DOG_TRANSPORT_LINUX
 #include <iom128.h>
+#endif
 
 /*----------------------------------------------------------------------------*/
 /* SPI Settings                                                               */
@@ -39,8 +69,10 @@
 
 /** SPI Status Register */     
 #define DOG_SPSR                 SPSR
-/** SPI Double SCK */
+/** SPI Double SCK bit position within @b DOG_SPSR */
 #define DOG_SPR2X                0
+/** Set to 1 if the MCU has the double SCK bit, 0 otherwise */
+#define DOG_HAS_SPR2X            1
 
 
 /** SPI Data Register */ 
@@ -65,6 +97,26 @@
 /** SPI Clock Speed  Bit 0 */
 #define DOG_SPR0                 0
 
+/** Port where the SCK pin resides (used when bit-banging) */
+#define DOG_SCK_PORT             PORTB
+/** Pin within @b DOG_SCK_PORT carrying SCK (used when bit-banging) */
+#define DOG_SCK_PIN              1
+/** Port where the MOSI pin resides (used when bit-banging) */
+#define DOG_MOSI_PORT            PORTB
+/** Pin within @b DOG_MOSI_PORT carrying MOSI (used when bit-banging) */
+#define DOG_MOSI_PIN             2
+
+/** SPI clock divider used by dog_init(): 2, 4, 8, 16, 32, 64 or 128. 
+ *  dog_spi_autotune() may be used instead to pick it from the MCU clock.
+ */
+#define DOG_SPI_DIVIDER          2
+/** Fastest SPI clock the DOG module accepts, in Hz */
+#define DOG_MAX_SCK_HZ           20000000UL
+/** Set to 1 to allow switching to a software (bit-banged) SPI at run time
+ *  with dog_spi_configure(). Setting it to 0 saves a test on every byte.
+ */
+#define DOG_BITBANG_FALLBACK     1
+
 /*----------------------------------------------------------------------------*/
 /* I/O Settings                                                               */
 /*----------------------------------------------------------------------------*/
@@ -90,6 +142,148 @@
  */                                    
 #define DOG_DATA_OR_COMMAND_PIN  4
 
+/*----------------------------------------------------------------------------*/
+/* Character Settings                                                         */
+/*----------------------------------------------------------------------------*/
+/** RAM budget, in bytes, of the cache of pre-shifted characters used when 
+ *  text is placed at rows which are not page-aligned. Each cached character
+ *  takes a pointer plus 13 bytes: 16 bytes on the AVR (24 on a 64-bit host).
+ *  The budget must hold between 1 and 255 characters. Set to 0 to remove the
+ *  cache altogether. The cache pays off where a shift by n bits costs n
+ *  instructions, as on the AVR; with a barrel shifter the search costs more
+ *  than the shifts it saves (test/text_bench measures both on the host).
+ */
+#ifndef DOG_GLYPH_CACHE_BYTES
+#define DOG_GLYPH_CACHE_BYTES    0
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* Layer Settings                                                             */
+/*----------------------------------------------------------------------------*/
+/** Number of layers composited by dog_layer_flush(), including the main 
+ *  buffer (layer 0). Every layer beyond the first takes up 1 KB of RAM.
+ */
+#ifndef DOG_LAYER_COUNT
+#define DOG_LAYER_COUNT          3
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* Incremental Update Settings                                                */
+/*----------------------------------------------------------------------------*/
+/** Set to 1 to compare the buffer with the shadow copy a machine word at a
+ *  time. Worthwhile on 32-bit and host targets; leave at 0 on 8-bit MCUs.
+ */
+#ifndef DOG_UPDATE_WORD_COMPARE
+#define DOG_UPDATE_WORD_COMPARE  0
+#endif
+
+/** Maximum number of separate runs of changed bytes tracked per page by the
+ *  update planner. Further changes on a page are merged into its last run.
+ */
+#ifndef DOG_PLAN_MAX_RUNS
+#define DOG_PLAN_MAX_RUNS        8
+#endif
+
+/** Cost of switching the A0 line between command and data mode, expressed
+ *  in transmitted bytes. Every reseek switches A0 twice. Raise this when
+ *  port writes are slow compared to the SPI clock.
+ */
+#ifndef DOG_A0_TOGGLE_COST
+#define DOG_A0_TOGGLE_COST       0
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* Row-Major Buffer Settings                                                  */
+/*----------------------------------------------------------------------------*/
+/** Set to 1 to build the row-major working buffer of DOGM128_rows.c, which
+ *  takes up another 1 KB of RAM. With 0 the module compiles to nothing, so
+ *  the layout is chosen here rather than by which files are linked.
+ */
+#ifndef DOG_ROW_MAJOR
+#define DOG_ROW_MAJOR            0
+#endif
+
+/** Width, in bits, of the words the row-major buffer is stored and spanned
+ *  in: 8, 16 or 32. Use 32 on 32-bit and host targets; on 8-bit MCUs wider
+ *  words only add shifts.
+ */
+#ifndef DOG_ROW_WORD_BITS
+#define DOG_ROW_WORD_BITS        8
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* Gauge Settings                                                             */
+/*----------------------------------------------------------------------------*/
+/** Largest number of needle positions of a gauge. The tip of each position
+ *  is stored in the gauge, taking up 2 bytes.
+ */
+#ifndef DOG_GAUGE_STEPS
+#define DOG_GAUGE_STEPS          64
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* Frame Scheduler Settings                                                   */
+/*----------------------------------------------------------------------------*/
+/** Shortest time between two frames sent by dog_frame_poll(), in ticks of
+ *  DOG_GET_TICKS(); this caps the frame rate. 0 sends a frame on every poll
+ *  that finds something to send, and must be used if there is no tick source.
+ */
+#ifndef DOG_FRAME_INTERVAL
+#define DOG_FRAME_INTERVAL       0
+#endif
+
+/** Data bytes a frame may spend on low-priority regions before the rest are
+ *  deferred to the next frame. High-priority regions are always sent.
+ */
+#ifndef DOG_FRAME_BUDGET
+#define DOG_FRAME_BUDGET         1024
+#endif
+
+/** Frames a low-priority region may be deferred before it is sent
+ *  regardless of the budget. Bounds the latency of low-priority updates.
+ */
+#ifndef DOG_FRAME_MAX_DEFER
+#define DOG_FRAME_MAX_DEFER      4
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* Statistics Settings                                                        */
+/*----------------------------------------------------------------------------*/
+/** Set to 1 to collect counters of the work done by the library in 
+ *  @b dog_stats (pixels, buffer bytes, SPI bytes, SPIF polling and flushes).
+ *  With 0, the counters cost neither code nor time.
+ */
+#ifndef DOG_STATS
+#define DOG_STATS                0
+#endif
+
+/** Expression reading a free-running tick counter, used to time flushes 
+ *  when @b DOG_STATS is set and to pace the frame scheduler, e.g. the count 
+ *  register of a timer. Ticks are subtracted as uint32_t, so the counter may
+ *  wrap. Leave at 0 if there is no tick source; flushes are then only 
+ *  counted.
+ */
+#ifndef DOG_GET_TICKS
+#define DOG_GET_TICKS()          0
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* Linux Settings                                                             */
+/*----------------------------------------------------------------------------*/
+/** Bytes collected by the Linux transport before they are handed to the 
+ *  kernel. A run of bytes sharing the same A0 level is sent in a single 
+ *  ioctl() as long as it fits; a full buffer update needs 1 KB.
+ */
+#ifndef DOG_LINUX_BATCH_BYTES
+#define DOG_LINUX_BATCH_BYTES    1024
+#endif
+
+/** Largest single transfer the spidev driver accepts (its bufsiz module 
+ *  parameter). Longer runs are split into several transfers of one message.
+ */
+#ifndef DOG_LINUX_MAX_TRANSFER
+#define DOG_LINUX_MAX_TRANSFER   4096
+#endif
 
 #endif /* DOGM128_USER_CONFIG_H */
 /** @} */ /* DOGM128_user_configuration */
\ No newline at end of file
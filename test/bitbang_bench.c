@@ -0,0 +1,106 @@
+/*
+ * @file   bitbang_bench.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Host check and benchmark of the bit-banged SPI transport. <br>
+ * @defgroup DOGM128_test_bitbang Bit-Bang Benchmark
+ * @{
+ *
+ * Built with @b DOG_TRANSPORT_BITBANG against the host GPIO stub.
+ *
+ * With @b DOG_GPIO_TRACE, every pin write is decoded back into SPI bytes
+ * and fed to the emulated controller; the program checks that the glass
+ * shows the buffer and reports how many pin writes each byte took.
+ *
+ * Without it, the pins are plain variables and the program times full
+ * buffer transfers, which shows the cost of the unrolled bit loop itself.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "DOGM128_driver.h"
+#include "gpio_stub.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Full buffer transfers timed by the benchmark */
+#define BENCH_FRAMES 2000
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to draw a scene which uses every byte value. */
+static void bench_scene(void)
+{
+  uint16_t i;
+
+  dog_clear_buffer();
+  dog_draw_string(0, 0, 0, DOG_ALIGN_LEFT, "Bit-bang transport", 0);
+  dog_draw_rectangle(0, 10, 127, 63, 0, 's');
+  dog_draw_arc(40, 37, 20, 0, 0, 0, 's');
+  dog_draw_line(70, 15, 120, 60, 0, 's');
+  for(i = 0; i < 256; ++i) dog_main_buffer[6 + (i >> 7)][i & 127] ^= i;
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int main(void)
+{
+#ifdef DOG_GPIO_TRACE
+  static dog_emu_t emu;
+  uint8_t frame[DOG_PAGE_HEIGHT][DOG_WIDTH];
+  uint32_t writes, bytes;
+
+  dog_emu_init(&emu);
+  dog_gpio_emu = &emu;
+  dog_init(DOG_NORMAL_DISPLAY, 0x16);
+  bench_scene();
+
+  writes = dog_gpio_writes;
+  bytes = emu.data + emu.commands;
+  dog_print_buffer();
+  writes = dog_gpio_writes - writes;
+  bytes = emu.data + emu.commands - bytes;
+
+  dog_emu_frame(&emu, frame);
+  if(memcmp(frame, dog_main_buffer, sizeof(frame)))
+  {
+    fprintf(stdout, "bitbang: FAIL, the glass does not show the buffer\n");
+    return 1;
+  }
+  fprintf(stdout, "bitbang: ok, %lu bytes in %lu pin writes "
+                  "(%.1f per byte)\n",
+          (unsigned long)bytes, (unsigned long)writes,
+          (double)writes / bytes);
+  return 0;
+#else
+  struct timespec start, end;
+  double seconds;
+  uint16_t i;
+
+  dog_init(DOG_NORMAL_DISPLAY, 0x16);
+  bench_scene();
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(i = 0; i < BENCH_FRAMES; ++i) dog_print_buffer();
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+  fprintf(stdout, "bitbang: %d frames in %.3f s, %.1f ns per data byte, "
+                  "%.0f frames/s\n", BENCH_FRAMES, seconds,
+          seconds * 1e9 / ((double)BENCH_FRAMES * DOG_PAGE_HEIGHT * DOG_WIDTH),
+          BENCH_FRAMES / seconds);
+  return 0;
+#endif /* DOG_GPIO_TRACE */
+}
+
+/* @} */ /* DOGM128_test_bitbang */
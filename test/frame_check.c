@@ -0,0 +1,199 @@
+/*
+ * @file   frame_check.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Host check of the frame scheduler. <br>
+ * @defgroup DOGM128_test_frame Frame Scheduler Check
+ * @{
+ *
+ * Built with @b DOG_TRANSPORT_LINUX, the emulated controller and the test
+ * tick source of stub/ticks.h, so that the time seen by the scheduler only
+ * moves when the check says so. The check drives dog_frame_poll() through
+ * coalescing within one frame interval, a low-priority page which does not
+ * fit the budget until @b DOG_FRAME_MAX_DEFER frames have passed, and a page
+ * holding changes of both priorities, and checks the frames sent, the glass
+ * and the latency statistics.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "DOGM128_driver.h"
+#include "DOGM128_emulator.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Report a failed expectation and count it */
+#define FRAME_EXPECT(cond)                                                 \
+        do { if(!(cond)) { ++failures;                                     \
+               fprintf(stdout, "frame: FAIL line %d: %s\n", __LINE__, #cond); \
+             } } while(0)
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static dog_emu_t emu
+ * @brief The emulated controller behind the Linux transport.
+ *
+ * @var static uint16_t failures
+ * @brief Expectations which did not hold.
+ */
+static dog_emu_t emu;
+static uint16_t failures = 0;
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to check whether the glass shows a page of the
+ *  buffer.
+ *
+ *  @par Parameters
+ *    - @a page = The page.
+ *
+ *  @returns Non-zero if it does.
+ */
+static uint8_t frame_shown(uint8_t page)
+{
+  uint8_t frame[DOG_PAGE_HEIGHT][DOG_WIDTH];
+
+  dog_emu_frame(&emu, frame);
+  return !memcmp(frame[page], dog_main_buffer[page], DOG_WIDTH);
+}
+
+/** Changes within one frame interval are sent together, in one frame. */
+static void frame_coalesce(void)
+{
+  dog_span_t span = {1, 1, 10, 19};
+  const dog_frame_stats_t *stats = dog_frame_stats();
+
+  dog_frame_configure(10, 1024);
+  dog_frame_stats_reset();
+
+  dog_test_ticks = 100;
+  dog_draw_pixel(3, 3, 's');
+  dog_frame_submit(DOG_PRIORITY_LOW);
+  FRAME_EXPECT(dog_frame_poll() == 1);                /* The first frame */
+
+  dog_test_ticks = 102;
+  dog_fill_rectangle(10, 8, 19, 15, 's');
+  dog_dirty_reset(&dog_main_dirty);
+  dog_frame_invalidate(&span, DOG_PRIORITY_LOW);
+  FRAME_EXPECT(dog_frame_poll() == 0);
+
+  dog_test_ticks = 105;
+  dog_fill_rectangle(0, 16, 127, 23, 's');
+  dog_frame_submit(DOG_PRIORITY_HIGH);
+  FRAME_EXPECT(dog_frame_poll() == 0);               /* Even when urgent */
+
+  dog_test_ticks = 107;
+  dog_fill_rectangle(40, 8, 49, 15, 's');
+  dog_frame_submit(DOG_PRIORITY_LOW);
+  FRAME_EXPECT(dog_frame_poll() == 0);
+  FRAME_EXPECT(!frame_shown(1) && !frame_shown(2));
+
+  dog_test_ticks = 110;
+  FRAME_EXPECT(dog_frame_poll() == 1);
+  FRAME_EXPECT(dog_frame_poll() == 0);                 /* Nothing pending */
+  FRAME_EXPECT(frame_shown(1) && frame_shown(2));
+
+  FRAME_EXPECT(stats->frames == 2);
+  FRAME_EXPECT(stats->invalidations == 4);
+  FRAME_EXPECT(stats->last_period == 10);
+  FRAME_EXPECT(stats->last_latency == 110 - 102);
+  FRAME_EXPECT(stats->max_latency == 110 - 102);
+}
+
+/** A low-priority page over budget waits, but not for ever. */
+static void frame_defer(void)
+{
+  const dog_frame_stats_t *stats = dog_frame_stats();
+  uint8_t i;
+
+  dog_frame_configure(0, 64);
+  dog_frame_stats_reset();
+
+  dog_test_ticks = 200;
+  dog_fill_rectangle(0, 24, 127, 31, 's');
+  dog_frame_submit(DOG_PRIORITY_LOW);
+
+  for(i = 1; i <= DOG_FRAME_MAX_DEFER; ++i)
+  {
+    dog_test_ticks = 200 + i;
+    FRAME_EXPECT(dog_frame_poll() == 0);
+    FRAME_EXPECT(!frame_shown(3));
+  }
+  FRAME_EXPECT(stats->deferrals == DOG_FRAME_MAX_DEFER);
+
+  dog_test_ticks = 201 + DOG_FRAME_MAX_DEFER;
+  FRAME_EXPECT(dog_frame_poll() == 1);               /* Forced out at last */
+  FRAME_EXPECT(frame_shown(3));
+  FRAME_EXPECT(stats->frames == 1);
+  FRAME_EXPECT(stats->last_bytes == DOG_WIDTH);
+  FRAME_EXPECT(stats->last_latency == 1 + DOG_FRAME_MAX_DEFER);
+  FRAME_EXPECT(stats->max_latency == 1 + DOG_FRAME_MAX_DEFER);
+}
+
+/** Changes of both priorities on one page are sent as one region; the part
+ *  the low-priority change adds to it counts against the budget. */
+static void frame_mixed(void)
+{
+  const dog_frame_stats_t *stats = dog_frame_stats();
+
+  dog_frame_configure(0, 64);
+  dog_frame_stats_reset();
+
+  dog_test_ticks = 300;
+  dog_fill_rectangle(0, 40, 9, 47, 's');
+  dog_frame_submit(DOG_PRIORITY_HIGH);
+  dog_fill_rectangle(100, 40, 109, 47, 's');
+  dog_fill_rectangle(0, 48, 59, 55, 's');
+  dog_frame_submit(DOG_PRIORITY_LOW);
+
+  /* The union of page 5 is 110 columns, so page 5 and page 6 (60 columns)
+   * cannot both be taken, whichever comes first */
+  dog_test_ticks = 301;
+  FRAME_EXPECT(dog_frame_poll() == 1);
+  FRAME_EXPECT(stats->deferrals == 1);
+  FRAME_EXPECT(frame_shown(5) != frame_shown(6));
+
+  dog_test_ticks = 302;
+  FRAME_EXPECT(dog_frame_poll() == 1);
+  FRAME_EXPECT(dog_frame_poll() == 0);
+  FRAME_EXPECT(frame_shown(5) && frame_shown(6));
+  FRAME_EXPECT(stats->max_latency == 2);
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int main(void)
+{
+  dog_emu_init(&emu);
+  dog_emu_attach(&emu);
+  if(dog_linux_open("/dev/null", "/dev/null", 0, 1) < 0)
+  {
+    fprintf(stdout, "frame: cannot open the transport\n");
+    return 1;
+  }
+  dog_init(DOG_NORMAL_DISPLAY, 0x16);
+  dog_clear_buffer();
+  dog_update_invalidate();
+  dog_update_flush();
+
+  frame_coalesce();
+  frame_defer();
+  frame_mixed();
+
+  if(failures) return 1;
+  fprintf(stdout, "frame: ok\n");
+  return 0;
+}
+
+/* @} */ /* DOGM128_test_frame */
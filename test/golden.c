@@ -0,0 +1,626 @@
+/*
+ * @file   golden.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Golden-image regression tests for the EA DOGM128 library. <br>
+ * @defgroup DOGM128_test_golden Golden Images
+ * @{
+ *
+ * Each test draws with one part of the library and sends the result through
+ * the Linux transport into the emulated controller. The image the glass
+ * shows is saved as out/<name>.pbm and compared byte for byte with
+ * golden/<name>.pbm.
+ *
+ * After a deliberate change to the output, check the new images in out/
+ * and run "golden_check --update" to make them the reference.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "DOGM128_driver.h"
+#include "DOGM128_emulator.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Largest PBM file written by the emulator: header and 1 KB of pixels */
+#define GOLDEN_MAX_FILE 1100
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** used to describe one test */
+typedef struct
+{
+  const char *name;         /**< name of the image files                  */
+  void (*draw)(void);       /**< draws and sends the image                */
+} golden_test_t;
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static dog_emu_t emu
+ * @brief The emulated controller behind the Linux transport.
+ */
+static dog_emu_t emu;
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** Pixels, set and cleared one at a time */
+static void golden_pixel(void)
+{
+  uint8_t i;
+
+  dog_fill_rectangle(64, 0, 127, 63, 's');
+  for(i = 0; i < 64; ++i)
+  {
+    dog_draw_pixel(i, i, 's');
+    dog_draw_pixel(i, 127 - i, 'c');
+    dog_draw_pixel(63 - i, 32 + (i >> 1), 's');
+  }
+  dog_print_buffer();
+}
+
+/** Points of each size */
+static void golden_point(void)
+{
+  uint8_t size;
+
+  dog_fill_rectangle(0, 32, 127, 63, 's');
+  for(size = 0; size < 3; ++size)
+  {
+    dog_draw_point(10, 10 + 30*size, size, 's');
+    dog_draw_point(45, 10 + 30*size, size, 'c');
+  }
+  dog_print_buffer();
+}
+
+/** Horizontal and vertical lines */
+static void golden_hv_lines(void)
+{
+  uint8_t i;
+
+  for(i = 0; i < 6; ++i)
+  {
+    dog_draw_h_line(i * 3, 127 - i * 5, 2 + i * 9, i & 1, 's');
+    dog_draw_v_line(70 + i * 9, i * 2, 63 - i * 3, i & 1, 's');
+  }
+  dog_draw_h_line(0, 127, 60, 0, 'c');
+  dog_draw_v_line(100, 0, 63, 0, 'c');
+  dog_print_buffer();
+}
+
+/** Lines in every direction */
+static void golden_lines(void)
+{
+  uint8_t i;
+
+  for(i = 0; i < 16; ++i)
+  {
+    dog_draw_line(32, 32, 32 + dog_cos(i * 16) * 30 / 64,
+                  32 + dog_sin(i * 16) * 30 / 64, 0, 's');
+    dog_draw_line(96, 32, 96 + dog_cos(i * 16 + 8) * 28 / 64,
+                  32 + dog_sin(i * 16 + 8) * 28 / 64, 1, 's');
+  }
+  dog_print_buffer();
+}
+
+/** Rectangle outlines */
+static void golden_rectangle(void)
+{
+  dog_draw_rectangle(0, 0, 127, 63, 0, 's');
+  dog_draw_rectangle(5, 5, 60, 30, 1, 's');
+  dog_draw_rectangle(70, 9, 120, 55, 2, 's');
+  dog_draw_rectangle(10, 40, 50, 58, 0, 's');
+  dog_print_buffer();
+}
+
+/** Filled rectangles in each mode, across page boundaries */
+static void golden_fill_rectangle(void)
+{
+  dog_fill_rectangle(3, 3, 60, 40, 's');
+  dog_fill_rectangle(10, 13, 40, 21, 'c');
+  dog_fill_rectangle(30, 30, 90, 61, 'x');
+  dog_fill_rectangle(100, 1, 101, 62, 's');
+  dog_fill_rectangle(110, 7, 125, 8, 'x');
+  dog_print_buffer();
+}
+
+/** Circles and arcs */
+static void golden_arcs(void)
+{
+  dog_draw_arc(32, 32, 30, 0, 0, 0, 's');
+  dog_draw_arc(32, 32, 20, 0, 0, 1, 's');
+  dog_draw_arc(96, 32, 28, 32, 160, 0, 's');
+  dog_draw_arc(96, 32, 12, 200, 40, 1, 's');
+  dog_print_buffer();
+}
+
+/** Text through putchar(), by row, by field and by glyph */
+static void golden_text(void)
+{
+  /* Through a pointer, so that a stdio inline cannot stand in for the
+   * library's putchar() */
+  int (*volatile put)(int) = putchar;
+  const char *s;
+
+  dog_set_page(0);
+  dog_set_column(0);
+  for(s = "putchar 0-9"; *s; ++s) put(*s);
+  dog_putchar_select(11, 3, 'R');
+  dog_putchar_select(13, 10, 'o');
+  dog_putchar_select(15, 17, 'w');
+  dog_draw_string_row(21, 30, "row 21", 0);
+  dog_draw_string(4, 0, 128, DOG_ALIGN_CENTER, "centered", 0);
+  dog_draw_string(5, 0, 128, DOG_ALIGN_RIGHT, "right", 0);
+  dog_draw_string(6, 0, 40, DOG_ALIGN_LEFT, "truncated text", 0);
+  dog_draw_string(7, 0, 0, DOG_ALIGN_LEFT, "UTF-8 \xC2\xB0 \xE2\x82\xAC", 0);
+  dog_draw_glyph(7, 120, 'Z');
+  dog_print_buffer();
+}
+
+/** Broken and 4-byte UTF-8, through putchar() on the top half and through
+ *  dog_draw_string() on the bottom half; both halves must look the same */
+static void golden_utf8(void)
+{
+  static const char *const lines[] =
+  {
+    "4:\xF0\x9F\x98\x80.",              /* 4-byte sequence: one '?' */
+    "new:\xE2\xC2\xB0.",               /* Cut short by a lead byte: ?° */
+    "lone:\x80\xBF.",                  /* Lone continuations: ?? */
+    "end:\xE2\x82"                     /* Cut short by the end: ? */
+  };
+  int (*volatile put)(int) = putchar;
+  const char *s;
+  uint8_t i;
+
+  dog_set_page(0);
+  dog_set_column(0);
+  for(i = 0; i < 4; ++i)
+  {
+    for(s = lines[i]; *s; ++s) put(*s);
+    put('\n');
+    dog_draw_string(4 + i, 0, 0, DOG_ALIGN_LEFT, lines[i], 0);
+  }
+  dog_print_buffer();
+}
+
+/** Integers and fixed-point numbers */
+static void golden_numeric(void)
+{
+  dog_draw_int(0, 0, 0, 0, 0, 0);
+  dog_draw_int(1, 0, -32768, 0, 0, 0);
+  dog_draw_int(2, 0, 2147483647L, 0, 0, 0);
+  dog_draw_int(3, 0, 42, 8, DOG_NUM_ZERO_PAD, 0);
+  dog_draw_fixed(4, 0, 31416, 4, 0, 0, 0);
+  dog_draw_fixed(5, 0, -5, 2, 0, 0, 0);
+  dog_draw_fixed(6, 0, 123456, 3, 10, 0, 0);
+  dog_print_buffer();
+}
+
+/** Region scrolling in each direction */
+static void golden_scroll(void)
+{
+  uint8_t i;
+
+  for(i = 0; i < 8; ++i)
+    dog_draw_string(i, 0, 128, DOG_ALIGN_LEFT, "0123456789ABCDEFGHIJ", 0);
+  dog_scroll_h(4, 3, 60, 28, 5, 's');
+  dog_scroll_h(70, 3, 120, 28, -9, 'c');
+  dog_scroll_v(4, 33, 60, 60, 3, 'c');
+  dog_scroll_v(70, 33, 120, 60, -11, 's');
+  dog_print_buffer();
+}
+
+/** Bars, progress bars and level meters */
+static void golden_bar(void)
+{
+  dog_bar_t bar;
+
+  dog_bar_init(&bar, 0, 0, 128, 8, 100, 0, 0, 0);
+  dog_bar_update(&bar, 37, 0);
+  dog_bar_init(&bar, 0, 12, 128, 12, 100, 0, 0, DOG_BAR_FRAME);
+  dog_bar_update(&bar, 81, 0);
+  dog_bar_init(&bar, 0, 28, 128, 6, 10, 10, 2, 0);
+  dog_bar_update(&bar, 6, 0);
+  dog_bar_init(&bar, 100, 36, 10, 28, 64, 0, 0, DOG_BAR_VERTICAL);
+  dog_bar_update(&bar, 40, 0);
+  dog_bar_init(&bar, 114, 36, 12, 28, 8, 8, 1,
+               DOG_BAR_VERTICAL | DOG_BAR_FRAME);
+  dog_bar_update(&bar, 3, 0);
+  dog_print_buffer();
+}
+
+/** A needle gauge with its dial */
+static void golden_gauge(void)
+{
+  dog_gauge_t gauge;
+
+  dog_gauge_init(&gauge, 64, 60, 50, 128, 128, 100);
+  dog_gauge_draw_dial(&gauge, 11);
+  dog_gauge_update(&gauge, 30, 0);
+  dog_gauge_update(&gauge, 65, 0);
+  dog_print_buffer();
+}
+
+/** A strip chart after it has scrolled */
+static void golden_chart(void)
+{
+  dog_chart_t chart;
+  uint16_t i;
+
+  dog_draw_rectangle(9, 7, 120, 56, 0, 's');
+  dog_chart_init(&chart, 10, 8, 110, 48, -64, 64, 2);
+  for(i = 0; i < 300; ++i) dog_chart_push(&chart, dog_sin(i * 5), 0);
+  dog_print_buffer();
+}
+
+/** A strip chart which could not scroll in portrait keeps the samples it was
+ *  given meanwhile; the last column spans all of them */
+static void golden_chart_refused(void)
+{
+  dog_chart_t chart;
+
+  dog_chart_init(&chart, 10, 8, 110, 48, -64, 64, 1);
+  dog_chart_push(&chart, 0, 0);
+  dog_set_orientation(DOG_ORIENT_90);
+  if(dog_chart_push(&chart, 60, 0) != -1) return;         /* Refused */
+  if(dog_chart_push(&chart, -60, 0) != -1) return;
+  dog_set_orientation(DOG_ORIENT_0);
+  dog_chart_push(&chart, 10, 0);
+  dog_print_buffer();
+}
+
+/** Fetches the items of the test menu */
+static const char *golden_menu_item(uint16_t index)
+{
+  static char text[5 + DOG_NUM_MAX_CHARS + 1];
+
+  strcpy(text, "Item ");
+  dog_format_int(text + 5, index, 0, 0);
+  return text;
+}
+
+/** A menu which has scrolled and jumped */
+static void golden_menu(void)
+{
+  dog_menu_t menu;
+
+  dog_draw_string(0, 0, 128, DOG_ALIGN_CENTER, "Menu", 0);
+  dog_menu_init(&menu, 1, 6, 8, 112, 200, golden_menu_item);
+  dog_menu_draw(&menu);
+  dog_menu_move(&menu, 8, 0);
+  dog_menu_select(&menu, 150, 0);
+  dog_menu_move(&menu, -7, 0);
+  dog_print_buffer();
+}
+
+/** A popup saved under and closed again, next to one left open */
+static void golden_save(void)
+{
+  static uint8_t under[DOG_SAVE_BYTES(DOG_PAGE_HEIGHT, DOG_WIDTH)];
+  dog_save_t save;
+  dog_span_t span;
+  uint16_t size;
+
+  dog_draw_arc(64, 32, 30, 0, 0, 1, 's');
+  dog_draw_line(0, 0, 127, 63, 0, 's');
+
+  size = dog_save_span(20, 10, 60, 40, &span);
+  dog_save_under(&save, &span, under, size);
+  dog_fill_rectangle(20, 10, 60, 40, 'x');
+  dog_restore_under(&save);
+
+  dog_fill_rectangle(80, 8, 120, 30, 'c');
+  dog_draw_rectangle(80, 8, 120, 30, 0, 's');
+  dog_draw_string(2, 84, 32, DOG_ALIGN_CENTER, "open", 0);
+  dog_print_buffer();
+}
+
+/** Layers combined by each blend mode */
+static void golden_layers(void)
+{
+  dog_layer_select(0);
+  dog_fill_rectangle(0, 0, 63, 63, 's');
+  dog_draw_string(7, 70, 0, DOG_ALIGN_LEFT, "base", 0);
+
+  dog_layer_select(1);
+  dog_layer_set_blend(1, DOG_BLEND_XOR);
+  dog_fill_rectangle(32, 16, 95, 47, 's');
+  dog_layer_show(1, 1);
+
+  dog_layer_select(2);
+  dog_layer_set_blend(2, DOG_BLEND_OR);
+  dog_draw_arc(100, 20, 15, 0, 0, 1, 's');
+  dog_layer_show(2, 1);
+
+  dog_layer_select(0);
+  dog_layer_flush();
+
+  /* Leave the layers as dog_init() would not reset them */
+  dog_layer_clear(1);
+  dog_layer_clear(2);
+  dog_layer_show(1, 0);
+  dog_layer_show(2, 0);
+  dog_layer_set_blend(1, DOG_BLEND_OR);
+}
+
+/** Row-major spans, rectangles and bitmaps, committed to the main buffer */
+static void golden_rows(void)
+{
+  static const uint8_t arrow[8] = {0x08, 0x0C, 0xFE, 0xFF,
+                                   0xFE, 0x0C, 0x08, 0x00};
+  uint8_t y;
+
+  dog_rows_load();
+  for(y = 0; y < 64; y += 3) dog_rows_h_span(y, 127 - y, y, 's');
+  dog_rows_fill_rectangle(13, 20, 50, 30, 'x');
+  dog_rows_draw_bitmap(100, 5, arrow, 8, 8);
+  dog_rows_draw_bitmap(101, 40, arrow, 8, 8);
+  dog_rows_pixel(127, 63, 's');
+  dog_rows_commit();
+  dog_print_buffer();
+}
+
+/** The same scene drawn in a given orientation */
+static void golden_oriented(dog_orientation_t orientation)
+{
+  dog_set_orientation(orientation);
+
+  /* A mode which does not exist must be refused and change nothing; if it
+   * is not, the image is left blank */
+  if(dog_set_orientation((dog_orientation_t)(DOG_ORIENT_270 + 1)) == 0)
+    return;
+
+  dog_draw_line(0, 0, 40, 20, 0, 's');
+  dog_draw_rectangle(2, 30, 30, 60, 0, 's');
+  dog_draw_pixel(1, 50, 's');
+  dog_draw_arc(50, 40, 10, 0, 64, 0, 's');
+  dog_print_buffer();
+}
+
+static void golden_orient_180(void)
+{
+  golden_oriented(DOG_ORIENT_180);
+}
+
+static void golden_orient_mirror_x(void)
+{
+  golden_oriented(DOG_ORIENT_MIRROR_X);
+}
+
+static void golden_orient_mirror_y(void)
+{
+  golden_oriented(DOG_ORIENT_MIRROR_Y);
+}
+
+static void golden_orient_90(void)
+{
+  golden_oriented(DOG_ORIENT_90);
+}
+
+static void golden_orient_270(void)
+{
+  golden_oriented(DOG_ORIENT_270);
+}
+
+/** Inverse display */
+static void golden_inverted(void)
+{
+  dog_invert_pixels(DOG_INVERTED_DISPLAY);
+  dog_draw_string(3, 0, 128, DOG_ALIGN_CENTER, "inverted", 0);
+  dog_print_buffer();
+}
+
+/** A full frame followed by incremental updates */
+static void golden_update(void)
+{
+  uint8_t i;
+
+  dog_draw_rectangle(0, 0, 127, 63, 0, 's');
+  dog_draw_string(1, 4, 0, DOG_ALIGN_LEFT, "before", 0);
+  dog_update_flush();
+
+  dog_draw_string(1, 4, 0, DOG_ALIGN_LEFT, "after!", 0);
+  for(i = 0; i < 8; ++i) dog_draw_pixel(30 + i * 3, 10 + i * 14, 's');
+  dog_update_flush();
+  dog_fill_rectangle(60, 40, 70, 50, 's');
+  dog_update_flush();
+}
+
+/** The first frame of a grayscale image, which shows every level but
+ *  white */
+static void golden_gray(void)
+{
+  uint8_t level;
+
+  dog_gray_clear();
+  for(level = 0; level < DOG_GRAY_LEVELS; ++level)
+    dog_gray_fill_rectangle(level * 32, 8 * level, 32, 40, level);
+  dog_gray_tick();
+  dog_gray_clear();
+}
+
+/** A keyframe and a delta decoded from the remote protocol */
+static void golden_remote(void)
+{
+  static uint8_t frame[DOG_PAGE_HEIGHT][DOG_WIDTH];
+  static uint8_t sent[DOG_PAGE_HEIGHT][DOG_WIDTH];
+  static uint8_t packet[DOG_REMOTE_MAX_PACKET];
+  dog_remote_t remote;
+  uint16_t length, i;
+
+  /* Draw the frames into a separate buffer, as the sender would */
+  dog_set_draw_target(frame, &dog_main_dirty);
+  dog_clear_buffer();
+  dog_draw_arc(64, 32, 25, 0, 0, 1, 's');
+  length = dog_remote_encode_key(frame, sent, packet, sizeof(packet));
+  dog_set_draw_target(dog_main_buffer, &dog_main_dirty);
+
+  dog_remote_init(&remote);
+  for(i = 0; i < length; ++i) dog_remote_feed(&remote, packet[i]);
+
+  dog_set_draw_target(frame, &dog_main_dirty);
+  dog_draw_string(3, 40, 48, DOG_ALIGN_CENTER, "delta", 0);
+  length = dog_remote_encode(frame, sent, packet, sizeof(packet));
+  dog_set_draw_target(dog_main_buffer, &dog_main_dirty);
+
+  for(i = 0; i < length; ++i) dog_remote_feed(&remote, packet[i]);
+  dog_update_flush();
+}
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static const golden_test_t tests[]
+ * @brief Every test, in the order they are run.
+ */
+static const golden_test_t tests[] =
+{
+  {"pixel",          golden_pixel},
+  {"point",          golden_point},
+  {"hv_lines",       golden_hv_lines},
+  {"lines",          golden_lines},
+  {"rectangle",      golden_rectangle},
+  {"fill_rectangle", golden_fill_rectangle},
+  {"arcs",           golden_arcs},
+  {"text",           golden_text},
+  {"utf8",           golden_utf8},
+  {"numeric",        golden_numeric},
+  {"scroll",         golden_scroll},
+  {"bar",            golden_bar},
+  {"gauge",          golden_gauge},
+  {"chart",          golden_chart},
+  {"chart_refused",  golden_chart_refused},
+  {"menu",           golden_menu},
+  {"save",           golden_save},
+  {"layers",         golden_layers},
+  {"rows",           golden_rows},
+  {"orient_180",     golden_orient_180},
+  {"orient_mirror_x",golden_orient_mirror_x},
+  {"orient_mirror_y",golden_orient_mirror_y},
+  {"orient_90",      golden_orient_90},
+  {"orient_270",     golden_orient_270},
+  {"inverted",       golden_inverted},
+  {"update",         golden_update},
+  {"gray",           golden_gray},
+  {"remote",         golden_remote},
+};
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to read a whole file.
+ *
+ *  @par Parameters
+ *    - @a path = The file.
+ *    - @a data = Receives the contents; @b GOLDEN_MAX_FILE bytes.
+ *
+ *  @returns The size of the file, or -1 if it cannot be read.
+ */
+static long golden_read(const char *path, uint8_t *data)
+{
+  FILE *file = fopen(path, "rb");
+  long size;
+
+  if(!file) return -1;
+  size = (long)fread(data, 1, GOLDEN_MAX_FILE, file);
+  fclose(file);
+  return size;
+}
+
+/** This function is used to write a whole file.
+ *
+ *  @returns Zero upon success, -1 otherwise.
+ */
+static int8_t golden_write(const char *path, const uint8_t *data, long size)
+{
+  FILE *file = fopen(path, "wb");
+  int8_t result;
+
+  if(!file) return -1;
+  result = (fwrite(data, 1, size, file) == (size_t)size) ? 0 : -1;
+  if(fclose(file)) result = -1;
+  return result;
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int main(int argc, char **argv)
+{
+  static uint8_t actual[GOLDEN_MAX_FILE], expected[GOLDEN_MAX_FILE];
+  char out_path[64], golden_path[64];
+  long actual_size, expected_size;
+  uint8_t update = (argc > 1 && !strcmp(argv[1], "--update"));
+  uint8_t i, failed = 0;
+
+  mkdir("out", 0777);
+  dog_emu_attach(&emu);
+  if(dog_linux_open("/dev/null", "/dev/null", 0, 1) < 0)
+  {
+    fprintf(stdout, "golden: cannot open the transport\n");
+    return 1;
+  }
+
+  for(i = 0; i < sizeof(tests) / sizeof(tests[0]); ++i)
+  {
+    /* Start every test from a freshly powered-up display */
+    dog_emu_init(&emu);
+    dog_set_draw_target(dog_main_buffer, &dog_main_dirty);
+    dog_init(DOG_NORMAL_DISPLAY, 0x16);
+    dog_set_orientation(DOG_ORIENT_0);
+    dog_invert_pixels(DOG_NORMAL_DISPLAY);
+    dog_clear_buffer();
+    dog_update_invalidate();
+
+    tests[i].draw();
+
+    sprintf(out_path, "out/%s.pbm", tests[i].name);
+    sprintf(golden_path, "golden/%s.pbm", tests[i].name);
+    if(dog_emu_write_pbm(&emu, out_path) < 0 ||
+       (actual_size = golden_read(out_path, actual)) < 0)
+    {
+      fprintf(stdout, "golden: cannot write %s\n", out_path);
+      return 1;
+    }
+
+    if(update)
+    {
+      if(golden_write(golden_path, actual, actual_size) < 0)
+      {
+        fprintf(stdout, "golden: cannot write %s\n", golden_path);
+        return 1;
+      }
+      continue;
+    }
+
+    expected_size = golden_read(golden_path, expected);
+    if(expected_size != actual_size || memcmp(actual, expected, actual_size))
+    {
+      fprintf(stdout, "golden: FAIL %s (see %s)\n", tests[i].name, out_path);
+      ++failed;
+    }
+  }
+
+  dog_linux_close();
+  if(update)
+    fprintf(stdout, "golden: %u reference images written\n", i);
+  else if(!failed)
+    fprintf(stdout, "golden: ok, %u images match\n", i);
+  return failed ? 1 : 0;
+}
+
+/* @} */ /* DOGM128_test_golden */
@@ -0,0 +1,171 @@
+/*
+ * @file   gray_check.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Host check and refresh cost of the grayscale mode. <br>
+ * @defgroup DOGM128_test_gray Grayscale Check
+ * @{
+ *
+ * Built with @b DOG_TRANSPORT_LINUX and the emulated controller. Two 20 x 10
+ * boxes of the gray levels and a small black one are drawn, and
+ * dog_gray_tick() is run for a few cycles. Every frame on the glass must be
+ * the combination of the planes that frame stands for, the frames of a cycle
+ * must darken each pixel as often as its level says, and once the first frame
+ * is out each tick must send only the bytes of the boxes whose pixels change.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "DOGM128_driver.h"
+#include "DOGM128_emulator.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Cycles run after the first frame */
+#define GRAY_CYCLES 4
+/** Columns of each gray box */
+#define GRAY_BOX_WIDTH 20
+/** Pages each gray box spans */
+#define GRAY_BOX_PAGES 2
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static dog_emu_t emu
+ * @brief The emulated controller behind the Linux transport.
+ */
+static dog_emu_t emu;
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to work out what a frame should look like.
+ *
+ *  @par Parameters
+ *    - @a index    = The frame [0,DOG_GRAY_FRAMES-1].
+ *    - @a expected = Receives the frame.
+ */
+static void gray_expected(uint8_t index,
+                          uint8_t expected[DOG_PAGE_HEIGHT][DOG_WIDTH])
+{
+  uint8_t page, col, lo, hi;
+
+  for(page = 0; page < DOG_PAGE_HEIGHT; ++page)
+  {
+    for(col = 0; col < DOG_WIDTH; ++col)
+    {
+      lo = dog_gray_planes[0][page][col];
+      hi = dog_gray_planes[1][page][col];
+      expected[page][col] = (index == 0) ? lo | hi :
+                            (index == 1) ? hi : lo & hi;
+    }
+  }
+}
+
+/** This function is used to find the gray level of a pixel.
+ *
+ *  @par Parameters
+ *    - @a x = X coordinate of the pixel.
+ *    - @a y = Y coordinate of the pixel.
+ *
+ *  @returns The level [0,3].
+ */
+static uint8_t gray_level(uint8_t x, uint8_t y)
+{
+  uint8_t bit = 1 << (y & 7);
+
+  return ((dog_gray_planes[0][y >> 3][x] & bit) ? 1 : 0) |
+         ((dog_gray_planes[1][y >> 3][x] & bit) ? 2 : 0);
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int main(void)
+{
+  /* Leaving frame 0 drops the light box, leaving frame 1 the dark one, and
+   * frame 0 brings both back */
+  static const uint16_t cost[DOG_GRAY_FRAMES] =
+  {
+    2 * GRAY_BOX_WIDTH * GRAY_BOX_PAGES,
+    GRAY_BOX_WIDTH * GRAY_BOX_PAGES,
+    GRAY_BOX_WIDTH * GRAY_BOX_PAGES
+  };
+  static uint8_t dark[DOG_HEIGHT][DOG_WIDTH];
+  uint8_t frame[DOG_PAGE_HEIGHT][DOG_WIDTH];
+  uint8_t expected[DOG_PAGE_HEIGHT][DOG_WIDTH];
+  uint8_t tick, index, x, y;
+  uint16_t bytes, failures = 0;
+
+  dog_emu_init(&emu);
+  dog_emu_attach(&emu);
+  if(dog_linux_open("/dev/null", "/dev/null", 0, 1) < 0)
+  {
+    fprintf(stdout, "gray: cannot open the transport\n");
+    return 1;
+  }
+  dog_init(DOG_NORMAL_DISPLAY, 0x16);
+  dog_update_invalidate();
+
+  dog_gray_clear();
+  dog_gray_fill_rectangle(10, 4, GRAY_BOX_WIDTH, 10, 1);     /* Light gray */
+  dog_gray_fill_rectangle(60, 28, GRAY_BOX_WIDTH, 10, 2);    /* Dark gray */
+  dog_gray_fill_rectangle(100, 48, 10, 8, 3);                /* Black */
+
+  bytes = dog_gray_tick();
+  fprintf(stdout, "gray: bytes per tick %u", bytes);
+
+  /* Frame 0 has been shown; run whole cycles from frame 1 on */
+  for(tick = 1; tick <= GRAY_CYCLES * DOG_GRAY_FRAMES; ++tick)
+  {
+    index = tick % DOG_GRAY_FRAMES;
+    bytes = dog_gray_tick();
+    if(tick <= DOG_GRAY_FRAMES) fprintf(stdout, ", %u", bytes);
+    if(bytes != cost[index])
+    {
+      fprintf(stdout, "\ngray: FAIL, frame %u cost %u bytes, not %u", index,
+              bytes, cost[index]);
+      ++failures;
+    }
+
+    dog_emu_frame(&emu, frame);
+    gray_expected(index, expected);
+    if(memcmp(frame, expected, sizeof(frame)))
+    {
+      fprintf(stdout, "\ngray: FAIL, frame %u is not the planes", index);
+      ++failures;
+    }
+    for(y = 0; y < DOG_HEIGHT; ++y)
+      for(x = 0; x < DOG_WIDTH; ++x)
+        if(frame[y >> 3][x] & (1 << (y & 7))) ++dark[y][x];
+  }
+  fprintf(stdout, " ...\n");
+
+  /* Over whole cycles, a pixel of level g is dark g times a cycle */
+  for(y = 0; y < DOG_HEIGHT; ++y)
+  {
+    for(x = 0; x < DOG_WIDTH; ++x)
+    {
+      if(dark[y][x] != GRAY_CYCLES * gray_level(x, y))
+      {
+        fprintf(stdout, "gray: FAIL, pixel %u,%u is not level %u\n", x, y,
+                gray_level(x, y));
+        return 1;
+      }
+    }
+  }
+
+  if(failures) return 1;
+  fprintf(stdout, "gray: ok\n");
+  return 0;
+}
+
+/* @} */ /* DOGM128_test_gray */
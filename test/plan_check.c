@@ -0,0 +1,228 @@
+/*
+ * @file   plan_check.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Host check of the update planner. <br>
+ * @defgroup DOGM128_test_plan Update Planner Check
+ * @{
+ *
+ * Built with @b DOG_TRANSPORT_LINUX and the emulated controller. Sets of
+ * changes are built by hand and handed to dog_plan_build(); the check
+ * compares the segments with the ones the cost rules call for, and the cost
+ * of each plan with what resending whole pages or reseeking for every run
+ * would have cost. Finally, more runs than @b DOG_PLAN_MAX_RUNS are put on
+ * one page to check that dog_update_flush() stretches the last one over the
+ * rest and still leaves the glass showing the buffer.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "DOGM128_driver.h"
+#include "DOGM128_emulator.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Report a failed expectation and count it */
+#define PLAN_EXPECT(cond)                                                  \
+        do { if(!(cond)) { ++failures;                                     \
+               fprintf(stdout, "plan: FAIL line %d: %s\n", __LINE__, #cond); \
+             } } while(0)
+
+/** Every command of a full seek */
+#define PLAN_FULL_SEEK (DOG_SEEK_PAGE | DOG_SEEK_COL_HI | DOG_SEEK_COL_LO)
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static dog_emu_t emu
+ * @brief The emulated controller behind the Linux transport.
+ *
+ * @var static uint16_t failures
+ * @brief Expectations which did not hold.
+ */
+static dog_emu_t emu;
+static uint16_t failures = 0;
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to add a run to a set of changes.
+ *
+ *  @par Parameters
+ *    - @a changes = The set of changes.
+ *    - @a page    = Page of the run.
+ *    - @a first   = First column of the run.
+ *    - @a last    = Last column of the run.
+ */
+static void plan_run(dog_change_set_t *changes, uint8_t page, uint8_t first,
+                     uint8_t last)
+{
+  dog_run_t *run = &changes->runs[page][changes->count[page]++];
+
+  run->first = first;
+  run->last = last;
+}
+
+/** This function is used to compare a segment with the one expected.
+ *
+ *  @returns Non-zero if they are the same.
+ */
+static uint8_t plan_segment(const dog_plan_t *plan, uint8_t index,
+                            uint8_t page, uint8_t first, uint8_t last,
+                            uint8_t commands)
+{
+  const dog_segment_t *segment = &plan->segments[index];
+
+  return index < plan->count && segment->page == page &&
+         segment->first == first && segment->last == last &&
+         segment->commands == commands;
+}
+
+/** This function is used to check that a plan beats both simple strategies.
+ *
+ *  @returns Non-zero if it does.
+ */
+static uint8_t plan_beats_naive(const dog_plan_t *plan)
+{
+  uint16_t cost = plan->stats.command_bytes + plan->stats.data_bytes;
+
+  return cost <= plan->stats.full_page_bytes &&
+         cost <= plan->stats.per_run_bytes;
+}
+
+/** A one-byte gap costs no more than the seek over it, so it is sent. */
+static void plan_bridge(void)
+{
+  dog_change_set_t changes;
+  dog_plan_t plan;
+
+  memset(&changes, 0, sizeof(changes));
+  plan_run(&changes, 0, 10, 19);
+  plan_run(&changes, 0, 21, 30);
+  dog_plan_build(&changes, &plan);
+
+  PLAN_EXPECT(plan.count == 1);
+  PLAN_EXPECT(plan_segment(&plan, 0, 0, 10, 30, PLAN_FULL_SEEK));
+  PLAN_EXPECT(plan.stats.bridged_bytes == 1);
+  PLAN_EXPECT(plan.stats.data_bytes == 21);
+  PLAN_EXPECT(plan.stats.command_bytes == 3);
+  PLAN_EXPECT(plan_beats_naive(&plan));
+}
+
+/** A long gap across a change of the upper column nibble is skipped with
+ *  both column commands, but not the page command. */
+static void plan_reseek(void)
+{
+  dog_change_set_t changes;
+  dog_plan_t plan;
+
+  memset(&changes, 0, sizeof(changes));
+  plan_run(&changes, 0, 0, 9);
+  plan_run(&changes, 0, 40, 49);
+  dog_plan_build(&changes, &plan);
+
+  PLAN_EXPECT(plan.count == 2);
+  PLAN_EXPECT(plan_segment(&plan, 0, 0, 0, 9, PLAN_FULL_SEEK));
+  PLAN_EXPECT(plan_segment(&plan, 1, 0, 40, 49,
+                           DOG_SEEK_COL_HI | DOG_SEEK_COL_LO));
+  PLAN_EXPECT(plan.stats.bridged_bytes == 0);
+  PLAN_EXPECT(plan.stats.command_bytes == 5);
+  PLAN_EXPECT(plan_beats_naive(&plan));
+}
+
+/** A seek within the same upper nibble takes the lower column command
+ *  alone. */
+static void plan_short_seek(void)
+{
+  dog_change_set_t changes;
+  dog_plan_t plan;
+
+  memset(&changes, 0, sizeof(changes));
+  plan_run(&changes, 0, 16, 17);
+  plan_run(&changes, 0, 24, 25);
+  dog_plan_build(&changes, &plan);
+
+  PLAN_EXPECT(plan.count == 2);
+  PLAN_EXPECT(plan_segment(&plan, 1, 0, 24, 25, DOG_SEEK_COL_LO));
+  PLAN_EXPECT(plan.stats.command_bytes == 3 + 1);
+  PLAN_EXPECT(plan.stats.data_bytes == 4);
+  PLAN_EXPECT(plan_beats_naive(&plan));
+}
+
+/** The page which starts where the last one left the column address goes
+ *  next, so it needs no column commands. */
+static void plan_page_order(void)
+{
+  dog_change_set_t changes;
+  dog_plan_t plan;
+
+  memset(&changes, 0, sizeof(changes));
+  plan_run(&changes, 1, 0, 9);
+  plan_run(&changes, 2, 40, 49);
+  plan_run(&changes, 4, 10, 20);
+  dog_plan_build(&changes, &plan);
+
+  PLAN_EXPECT(plan.count == 3);
+  PLAN_EXPECT(plan_segment(&plan, 0, 1, 0, 9, PLAN_FULL_SEEK));
+  PLAN_EXPECT(plan_segment(&plan, 1, 4, 10, 20, DOG_SEEK_PAGE));
+  PLAN_EXPECT(plan_segment(&plan, 2, 2, 40, 49, PLAN_FULL_SEEK));
+  PLAN_EXPECT(plan.stats.command_bytes == 3 + 1 + 3);
+  PLAN_EXPECT(plan_beats_naive(&plan));
+}
+
+/** Changes beyond the last run a page can hold stretch that run. */
+static void plan_overflow(void)
+{
+  uint8_t frame[DOG_PAGE_HEIGHT][DOG_WIDTH];
+  const dog_plan_stats_t *stats;
+  uint8_t i;
+
+  dog_clear_buffer();
+  dog_update_invalidate();
+  dog_update_flush();
+
+  /* One more single-byte change than there are runs, 10 columns apart */
+  for(i = 0; i <= DOG_PLAN_MAX_RUNS; ++i) dog_draw_pixel(3, i * 10, 's');
+  dog_update_flush();
+  stats = dog_update_stats();
+
+  PLAN_EXPECT(stats->seeks == DOG_PLAN_MAX_RUNS);
+  PLAN_EXPECT(stats->data_bytes == (DOG_PLAN_MAX_RUNS - 1) + 11);
+  dog_emu_frame(&emu, frame);
+  PLAN_EXPECT(!memcmp(frame, dog_main_buffer, sizeof(frame)));
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int main(void)
+{
+  dog_emu_init(&emu);
+  dog_emu_attach(&emu);
+  if(dog_linux_open("/dev/null", "/dev/null", 0, 1) < 0)
+  {
+    fprintf(stdout, "plan: cannot open the transport\n");
+    return 1;
+  }
+  dog_init(DOG_NORMAL_DISPLAY, 0x16);
+
+  plan_bridge();
+  plan_reseek();
+  plan_short_seek();
+  plan_page_order();
+  plan_overflow();
+
+  if(failures) return 1;
+  fprintf(stdout, "plan: ok\n");
+  return 0;
+}
+
+/* @} */ /* DOGM128_test_plan */
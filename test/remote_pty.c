@@ -0,0 +1,232 @@
+/*
+ * @file   remote_pty.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  End-to-end check of the remote framebuffer protocol over a pty.
+ *         <br>
+ * @defgroup DOGM128_test_remote Remote Framebuffer Check
+ * @{
+ *
+ * Built with @b DOG_TRANSPORT_LINUX. A child process plays the sender: it
+ * encodes a prerecorded sequence of widget frames with dog_remote_encode()
+ * and writes the packets to the master side of a pty pair, damaging one of
+ * them on the way. The parent plays the receiver: it feeds every byte read
+ * from the slave side to dog_remote_feed() and flushes each complete frame
+ * to the emulated controller, whose glass must then show one of the frames
+ * sent, in order.
+ *
+ * A pty is not paced at its baud rate, so the frame rates reported are
+ * those the measured bytes per frame allow on a serial line with 8N1
+ * framing (10 bits per byte).
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pty.h>
+#include <termios.h>
+#include <sys/wait.h>
+#include "DOGM128_driver.h"
+#include "DOGM128_emulator.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Frames in the sequence */
+#define REMOTE_FRAMES   300
+/** The sender forces a keyframe every this many frames */
+#define REMOTE_KEY_EVERY 100
+/** Frame whose packet is damaged on the way */
+#define REMOTE_DAMAGED  120
+/** Every this many frames the whole picture changes, so that the encoder
+ *  should send a keyframe of its own accord */
+#define REMOTE_NOISE_EVERY 50
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static uint8_t scenes[REMOTE_FRAMES][DOG_PAGE_HEIGHT][DOG_WIDTH]
+ * @brief The frames to be sent, recorded before the sender is forked.
+ */
+static uint8_t scenes[REMOTE_FRAMES][DOG_PAGE_HEIGHT][DOG_WIDTH];
+
+/**
+ * @var static dog_emu_t emu
+ * @brief The emulated controller behind the Linux transport.
+ */
+static dog_emu_t emu;
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to record the frames: a gauge, a bar and a frame
+ *  counter which change on every frame, and now and then a burst of noise
+ *  over the whole picture.
+ */
+static void remote_record(void)
+{
+  dog_gauge_t gauge;
+  dog_bar_t bar;
+  char text[8];
+  uint8_t *byte;
+  uint16_t f, i;
+
+  srand(1);
+  dog_clear_buffer();
+  dog_gauge_init(&gauge, 40, 36, 28, 128, 128, 100);
+  dog_gauge_draw_dial(&gauge, 8);
+  dog_bar_init(&bar, 80, 8, 44, 12, 100, 0, 0, DOG_BAR_FRAME);
+
+  for(f = 0; f < REMOTE_FRAMES; ++f)
+  {
+    dog_gauge_update(&gauge, (f * 7) % 101, 0);
+    dog_bar_update(&bar, (f * 3) % 101, 0);
+    sprintf(text, "F%04u", f);
+    dog_draw_string(7, 80, 40, DOG_ALIGN_LEFT, text, 0);
+    if(f % REMOTE_NOISE_EVERY == REMOTE_NOISE_EVERY / 2)
+    {
+      byte = dog_main_buffer[0];
+      for(i = 0; i < DOG_PAGE_HEIGHT * DOG_WIDTH; ++i) *byte++ ^= rand();
+    }
+    memcpy(scenes[f], dog_main_buffer, sizeof(scenes[f]));
+  }
+}
+
+/** This function is used to send the frames, as the child process.
+ *
+ *  @par Parameters
+ *    - @a fd = The master side of the pty.
+ *
+ *  @returns The exit status of the child.
+ */
+static int remote_send(int fd)
+{
+  static uint8_t sent[DOG_PAGE_HEIGHT][DOG_WIDTH];
+  static uint8_t packet[DOG_REMOTE_MAX_PACKET];
+  uint16_t f, length, done;
+  ssize_t n;
+  uint8_t ack;
+
+  for(f = 0; f < REMOTE_FRAMES; ++f)
+  {
+    if(f % REMOTE_KEY_EVERY == 0)
+      length = dog_remote_encode_key(scenes[f], sent, packet, sizeof(packet));
+    else
+      length = dog_remote_encode(scenes[f], sent, packet, sizeof(packet));
+    if(f == REMOTE_DAMAGED) packet[length / 2] ^= 0x10;
+
+    for(done = 0; done < length; done += n)
+    {
+      n = write(fd, packet + done, length - done);
+      if(n <= 0) return 1;
+    }
+  }
+
+  /* Closing the master would hang up the slave; wait for the receiver */
+  return read(fd, &ack, 1) == 1 ? 0 : 1;
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int main(void)
+{
+  static const long bauds[] = {9600, 115200, 1000000};
+  uint8_t frame[DOG_PAGE_HEIGHT][DOG_WIDTH];
+  uint8_t bytes[512];
+  dog_remote_t remote;
+  struct termios raw;
+  int master, slave, status;
+  uint16_t next = 0, mismatched = 0;
+  unsigned long received = 0;
+  double per_frame;
+  ssize_t n, i;
+  pid_t pid;
+
+  remote_record();
+
+  if(openpty(&master, &slave, 0, 0, 0) < 0)
+  {
+    fprintf(stdout, "remote: cannot open a pty\n");
+    return 1;
+  }
+  tcgetattr(slave, &raw);
+  cfmakeraw(&raw);
+  tcsetattr(slave, TCSANOW, &raw);
+
+  pid = fork();
+  if(pid == 0)
+  {
+    close(slave);
+    _exit(remote_send(master));
+  }
+  close(master);
+
+  dog_emu_init(&emu);
+  dog_emu_attach(&emu);
+  if(dog_linux_open("/dev/null", "/dev/null", 0, 1) < 0)
+  {
+    fprintf(stdout, "remote: cannot open the transport\n");
+    return 1;
+  }
+  dog_init(DOG_NORMAL_DISPLAY, 0x16);
+  dog_clear_buffer();
+  dog_update_invalidate();
+  dog_remote_init(&remote);
+
+  /* Every packet is either shown, skipped or found damaged */
+  alarm(10);
+  while(remote.frames + remote.skipped + remote.errors < REMOTE_FRAMES)
+  {
+    n = read(slave, bytes, sizeof(bytes));
+    if(n <= 0) break;
+    received += n;
+
+    for(i = 0; i < n; ++i)
+    {
+      if(dog_remote_feed(&remote, bytes[i]) != DOG_REMOTE_FRAME) continue;
+
+      dog_update_flush();
+      dog_emu_frame(&emu, frame);
+      while(next < REMOTE_FRAMES &&
+            memcmp(frame, scenes[next], sizeof(frame))) ++next;
+      if(next == REMOTE_FRAMES)
+      {
+        ++mismatched;
+        next = 0;
+      }
+    }
+  }
+
+  if(write(slave, "", 1) != 1) return 1;
+  waitpid(pid, &status, 0);
+
+  per_frame = (double)received / REMOTE_FRAMES;
+  fprintf(stdout, "remote: %u frames shown, %u keyframes, %u damaged, "
+                  "%u skipped, %.1f bytes per frame\n",
+          remote.frames, remote.keyframes, remote.errors, remote.skipped,
+          per_frame);
+  for(i = 0; i < (ssize_t)(sizeof(bauds) / sizeof(bauds[0])); ++i)
+    fprintf(stdout, "remote: %.1f fps at %ld baud\n",
+            bauds[i] / 10.0 / per_frame, bauds[i]);
+
+  if(!WIFEXITED(status) || WEXITSTATUS(status) || mismatched ||
+     remote.errors != 1 ||
+     remote.frames + remote.skipped + remote.errors != REMOTE_FRAMES)
+  {
+    fprintf(stdout, "remote: FAIL, %u frames did not match\n", mismatched);
+    return 1;
+  }
+  fprintf(stdout, "remote: ok\n");
+  return 0;
+}
+
+/* @} */ /* DOGM128_test_remote */
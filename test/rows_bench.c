@@ -0,0 +1,171 @@
+/*
+ * @file   rows_bench.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Benchmark of the row-major buffer against the page-major one. <br>
+ * @defgroup DOGM128_test_rows Row-Major Benchmark
+ * @{
+ *
+ * Built with @b DOG_ROW_MAJOR. Horizontal spans, a filled rectangle and a
+ * bitmap import are each drawn over and over, once into the row-major buffer
+ * followed by dog_rows_commit(), and once straight into @b dog_main_buffer
+ * with the page-major equivalents: dog_draw_h_line(), dog_fill_rectangle()
+ * and dog_draw_pixel() for every set pixel of the bitmap. Both must leave
+ * the same image in the main buffer; the times of both are reported.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "DOGM128_driver.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Times each workload is drawn */
+#define BENCH_ROUNDS 20000
+/** Side of the square bitmap */
+#define BENCH_BITMAP 32
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** used to describe one workload */
+typedef struct
+{
+  const char *name;         /**< name printed with the times              */
+  void (*rows)(void);       /**< draws it into the row-major buffer       */
+  void (*pages)(void);      /**< draws it into the main buffer            */
+} bench_workload_t;
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static uint8_t bitmap[]
+ * @brief A checkerboard of 4 x 4 squares, in the layout of
+ *        dog_rows_draw_bitmap().
+ */
+static uint8_t bitmap[BENCH_BITMAP * BENCH_BITMAP / 8];
+
+/*----------------------------------------------------------------------------*/
+/* STATIC FUNCTIONS                                                           */
+/*----------------------------------------------------------------------------*/
+
+/** Spans across every row, through the row-major buffer */
+static void bench_rows_spans(void)
+{
+  uint8_t y;
+
+  for(y = 0; y < DOG_HEIGHT; ++y) dog_rows_h_span(3, 124, y, 's');
+  dog_rows_commit();
+}
+
+/** Spans across every row, straight into the main buffer */
+static void bench_pages_spans(void)
+{
+  uint8_t y;
+
+  for(y = 0; y < DOG_HEIGHT; ++y) dog_draw_h_line(3, 124, y, 0, 's');
+}
+
+/** A filled rectangle, through the row-major buffer */
+static void bench_rows_rectangle(void)
+{
+  dog_rows_fill_rectangle(5, 5, 100, 50, 's');
+  dog_rows_commit();
+}
+
+/** A filled rectangle, straight into the main buffer */
+static void bench_pages_rectangle(void)
+{
+  dog_fill_rectangle(5, 5, 104, 54, 's');
+}
+
+/** A bitmap, through the row-major buffer */
+static void bench_rows_bitmap(void)
+{
+  dog_rows_draw_bitmap(13, 9, bitmap, BENCH_BITMAP, BENCH_BITMAP);
+  dog_rows_commit();
+}
+
+/** A bitmap, straight into the main buffer one pixel at a time */
+static void bench_pages_bitmap(void)
+{
+  uint8_t x, y;
+
+  for(y = 0; y < BENCH_BITMAP; ++y)
+    for(x = 0; x < BENCH_BITMAP; ++x)
+      if(bitmap[y * (BENCH_BITMAP / 8) + (x >> 3)] & (1 << (x & 7)))
+        dog_draw_pixel(9 + y, 13 + x, 's');
+}
+
+/** This function is used to time a way of drawing a workload.
+ *
+ *  @par Parameters
+ *    - @a draw  = Draws the workload.
+ *    - @a image = Receives the main buffer after the first round.
+ *
+ *  @returns The time per round in nanoseconds.
+ */
+static double bench_time(void (*draw)(void),
+                         uint8_t image[DOG_PAGE_HEIGHT][DOG_WIDTH])
+{
+  struct timespec start, end;
+  uint16_t i;
+
+  dog_clear_buffer();
+  dog_rows_clear();
+  draw();
+  memcpy(image, dog_main_buffer, DOG_PAGE_HEIGHT * DOG_WIDTH);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(i = 0; i < BENCH_ROUNDS; ++i) draw();
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  return ((end.tv_sec - start.tv_sec) * 1e9 +
+          (end.tv_nsec - start.tv_nsec)) / BENCH_ROUNDS;
+}
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int main(void)
+{
+  static const bench_workload_t workloads[] =
+  {
+    {"spans",     bench_rows_spans,     bench_pages_spans},
+    {"rectangle", bench_rows_rectangle, bench_pages_rectangle},
+    {"bitmap",    bench_rows_bitmap,    bench_pages_bitmap}
+  };
+  uint8_t rows_image[DOG_PAGE_HEIGHT][DOG_WIDTH];
+  uint8_t pages_image[DOG_PAGE_HEIGHT][DOG_WIDTH];
+  double rows_ns, pages_ns;
+  uint16_t i;
+
+  for(i = 0; i < sizeof(bitmap); ++i)
+    bitmap[i] = (((i / (BENCH_BITMAP / 8)) >> 2) & 1) ? 0xF0 : 0x0F;
+
+  for(i = 0; i < sizeof(workloads) / sizeof(workloads[0]); ++i)
+  {
+    rows_ns = bench_time(workloads[i].rows, rows_image);
+    pages_ns = bench_time(workloads[i].pages, pages_image);
+    fprintf(stdout, "rows: %-9s %8.0f ns row-major + commit, %8.0f ns "
+                    "page-major (%.1fx)\n", workloads[i].name, rows_ns,
+            pages_ns, pages_ns / rows_ns);
+    if(memcmp(rows_image, pages_image, sizeof(rows_image)))
+    {
+      fprintf(stdout, "rows: FAIL, the %s images differ\n", workloads[i].name);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/* @} */ /* DOGM128_test_rows */
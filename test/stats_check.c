@@ -0,0 +1,115 @@
+/*
+ * @file   stats_check.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Host check of the statistics counters. <br>
+ * @defgroup DOGM128_test_stats Statistics Check
+ * @{
+ *
+ * Built with @b DOG_STATS, @b DOG_TRANSPORT_LINUX, the emulated controller
+ * and the test tick source of stub/ticks.h. A scene whose cost is known is
+ * drawn and sent whole, then a pixel is added and sent incrementally; the
+ * counters of @b dog_stats are compared with that cost and with the bytes
+ * the emulated controller received. dog_stats_reset() must then zero them.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "DOGM128_driver.h"
+#include "DOGM128_emulator.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Report a failed expectation and count it */
+#define STATS_EXPECT(cond)                                                 \
+        do { if(!(cond)) { ++failures;                                     \
+               fprintf(stdout, "stats: FAIL line %d: %s\n", __LINE__, #cond); \
+             } } while(0)
+
+/** Pixels drawn one at a time by the scene */
+#define STATS_PIXELS 16
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static dog_emu_t emu
+ * @brief The emulated controller behind the Linux transport.
+ *
+ * @var static uint16_t failures
+ * @brief Expectations which did not hold.
+ */
+static dog_emu_t emu;
+static uint16_t failures = 0;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int main(void)
+{
+  static const dog_stats_t zero;
+  uint8_t i;
+
+  dog_emu_init(&emu);
+  dog_emu_attach(&emu);
+  if(dog_linux_open("/dev/null", "/dev/null", 0, 1) < 0)
+  {
+    fprintf(stdout, "stats: cannot open the transport\n");
+    return 1;
+  }
+  dog_init(DOG_NORMAL_DISPLAY, 0x16);
+  dog_clear_buffer();
+  dog_update_invalidate();
+  dog_update_flush();
+
+  dog_stats_reset();
+  emu.commands = 0;
+  emu.data = 0;
+
+  /* A diagonal of pixels and a 64 x 16 rectangle over two whole pages */
+  dog_test_ticks = 1000;
+  for(i = 0; i < STATS_PIXELS; ++i) dog_draw_pixel(40 + i, i, 's');
+  dog_fill_rectangle(0, 16, 63, 31, 's');
+  dog_update_invalidate();
+  dog_update_flush();
+
+  STATS_EXPECT(dog_stats.pixels == STATS_PIXELS);
+  STATS_EXPECT(dog_stats.buffer_bytes == STATS_PIXELS + 2 * 64);
+  STATS_EXPECT(dog_stats.flushes == 1);
+  STATS_EXPECT(emu.data == DOG_PAGE_HEIGHT * DOG_WIDTH);
+  STATS_EXPECT(dog_stats.spi_bytes == emu.data + emu.commands);
+
+  /* One more pixel, sent incrementally */
+  dog_draw_pixel(63, 127, 's');
+  dog_update_flush();
+
+  STATS_EXPECT(dog_stats.pixels == STATS_PIXELS + 1);
+  STATS_EXPECT(dog_stats.buffer_bytes == STATS_PIXELS + 2 * 64 + 1);
+  STATS_EXPECT(dog_stats.flushes == 2);
+  STATS_EXPECT(emu.data == DOG_PAGE_HEIGHT * DOG_WIDTH + 1);
+  STATS_EXPECT(dog_stats.spi_bytes == emu.data + emu.commands);
+  STATS_EXPECT(dog_stats.busy_waits == 0);       /* No SPIF on the host */
+  STATS_EXPECT(dog_stats.flush_ticks == 0);   /* The test clock stood still */
+
+  fprintf(stdout, "stats: %lu pixels, %lu buffer bytes, %lu SPI bytes, "
+                  "%lu flushes\n",
+          (unsigned long)dog_stats.pixels,
+          (unsigned long)dog_stats.buffer_bytes,
+          (unsigned long)dog_stats.spi_bytes,
+          (unsigned long)dog_stats.flushes);
+
+  dog_stats_reset();
+  STATS_EXPECT(!memcmp(&dog_stats, &zero, sizeof(zero)));
+
+  if(failures) return 1;
+  fprintf(stdout, "stats: ok\n");
+  return 0;
+}
+
+/* @} */ /* DOGM128_test_stats */
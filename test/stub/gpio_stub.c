@@ -0,0 +1,86 @@
+/*
+ * @file   gpio_stub.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for the host GPIO stub. <br>
+ * @defgroup DOGM128_test_stub_source
+ * @{
+ *
+ * This file contains the port registers declared in the host iom128.h and,
+ * with @b DOG_GPIO_TRACE, a decoder which turns pin writes back into the
+ * bytes the DOG module would receive.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "gpio_stub.h"
+
+/*----------------------------------------------------------------------------*/
+/* GLOBAL DATA                                                                */
+/*----------------------------------------------------------------------------*/
+volatile unsigned char PORTB;
+volatile unsigned char DDRB;
+
+#ifdef DOG_GPIO_TRACE
+dog_emu_t *dog_gpio_emu = 0;
+uint32_t dog_gpio_writes = 0;
+
+/*----------------------------------------------------------------------------*/
+/* STATIC VARIABLES                                                           */
+/*----------------------------------------------------------------------------*/
+/**
+ * @var static uint8_t shift
+ * @brief Bits clocked in so far, MSB first.
+ *
+ * @var static uint8_t bits
+ * @brief Number of bits in @a shift.
+ */
+static uint8_t shift = 0;
+static uint8_t bits = 0;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+void dog_gpio_write(volatile unsigned char *port, unsigned char bit,
+                    unsigned char level)
+{
+  uint8_t before = *port;
+  uint8_t rising, falling;
+
+  if(level)
+    *port |= (uint8_t)(1 << bit);
+  else
+    *port &= (uint8_t)~(1 << bit);
+  ++dog_gpio_writes;
+
+  if(!dog_gpio_emu) return;
+  rising = !(before & (1 << bit)) && level;
+  falling = (before & (1 << bit)) && !level;
+
+  /* A deselected controller ignores SCK and drops any partial byte */
+  if(port == &DOG_SPI_PORT && bit == DOG_SS_BAR_PIN && rising) bits = 0;
+
+  if(port == &DOG_RESET_PORT && bit == DOG_RESET_PIN && falling)
+    dog_emu_hw_reset(dog_gpio_emu);
+
+  /* Sample MOSI on the rising edge of SCK (SPI mode 0) */
+  if(port == &DOG_SCK_PORT && bit == DOG_SCK_PIN && rising &&
+     !(DOG_SPI_PORT & (1 << DOG_SS_BAR_PIN)))
+  {
+    shift = (uint8_t)(shift << 1) |
+            ((DOG_MOSI_PORT >> DOG_MOSI_PIN) & 1);
+    if(++bits == 8)
+    {
+      dog_emu_write(dog_gpio_emu,
+                    (DOG_DATA_OR_COMMAND_PORT >> DOG_DATA_OR_COMMAND_PIN) & 1,
+                    &shift, 1);
+      bits = 0;
+    }
+  }
+}
+#endif /* DOG_GPIO_TRACE */
+
+/* @} */ /* DOGM128_test_stub_source */
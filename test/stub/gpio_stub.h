@@ -0,0 +1,31 @@
+/**
+ * @file   gpio_stub.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Header file for the host GPIO stub. <br>
+ * @addtogroup DOGM128_test_stub
+ * @{
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_TEST_GPIO_STUB_H
+#define DOGM128_TEST_GPIO_STUB_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "DOGM128_common.h"
+#include "DOGM128_emulator.h"
+
+#ifdef DOG_GPIO_TRACE
+/*----------------------------------------------------------------------------*/
+/* EXTERNAL DATA                                                              */
+/*----------------------------------------------------------------------------*/
+/** Emulator receiving the decoded bytes, or NULL to only count pin writes */
+extern dog_emu_t *dog_gpio_emu;
+/** Pin writes made since start-up */
+extern uint32_t dog_gpio_writes;
+#endif /* DOG_GPIO_TRACE */
+
+#endif /* DOGM128_TEST_GPIO_STUB_H */
+/** @} */ /* DOGM128_test_stub */
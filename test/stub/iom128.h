@@ -0,0 +1,58 @@
+/**
+ * @file   iom128.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Host stand-in for the ATMega128 register header. <br>
+ * @defgroup DOGM128_test_stub GPIO Stub
+ * @{
+ *
+ * This file lets the bit-banged transport (@b DOG_TRANSPORT_BITBANG) build
+ * and run on a PC. The port registers become plain variables, so the
+ * unrolled pin writes cost what they would cost on a fast MCU and can be
+ * timed.
+ *
+ * When @b DOG_GPIO_TRACE is defined, every pin write goes through
+ * dog_gpio_write() instead, which decodes the SPI bus like the DOG module
+ * would and feeds the bytes to an emulated controller.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_TEST_IOM128_H
+#define DOGM128_TEST_IOM128_H
+
+/*----------------------------------------------------------------------------*/
+/* EXTERNAL DATA                                                              */
+/*----------------------------------------------------------------------------*/
+/** Port B, which carries every pin of the DOG module in the default
+ *  configuration */
+extern volatile unsigned char PORTB;
+/** Data direction register of port B */
+extern volatile unsigned char DDRB;
+
+#ifdef DOG_GPIO_TRACE
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Set a pin through the bus decoder */
+#define SETBIT(port,bit)   dog_gpio_write(&(port), (bit), 1)
+/** Clear a pin through the bus decoder */
+#define CLEARBIT(port,bit) dog_gpio_write(&(port), (bit), 0)
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+/** This function is used to drive one pin of a stub port.
+ *
+ *  @par Parameters
+ *         - @a port  = The port.
+ *         - @a bit   = The pin within @a port [0,7].
+ *         - @a level = 1 to set the pin, 0 to clear it.
+ */
+void dog_gpio_write(volatile unsigned char *port, unsigned char bit,
+                    unsigned char level);
+#endif /* DOG_GPIO_TRACE */
+
+#endif /* DOGM128_TEST_IOM128_H */
+/** @} */ /* DOGM128_test_stub */
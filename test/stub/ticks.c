@@ -0,0 +1,23 @@
+/*
+ * @file   ticks.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Source code for the host tick source. <br>
+ * @defgroup DOGM128_test_ticks_source
+ * @{
+ *
+ * This file contains the counter declared in ticks.h.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "ticks.h"
+
+/*----------------------------------------------------------------------------*/
+/* GLOBAL DATA                                                                */
+/*----------------------------------------------------------------------------*/
+volatile unsigned long dog_test_ticks = 0;
+
+/* @} */ /* DOGM128_test_ticks_source */
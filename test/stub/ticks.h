@@ -0,0 +1,33 @@
+/**
+ * @file   ticks.h  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Host tick source for the checks. <br>
+ * @addtogroup DOGM128_test_stub
+ * @{
+ *
+ * Forced into every file of a check with -include, ahead of
+ * DOGM128_user_config.h, so that @b DOG_GET_TICKS() reads a counter which
+ * the check advances by hand. Times measured by the library then come out
+ * exactly as the check expects.
+ *
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef DOGM128_TEST_TICKS_H
+#define DOGM128_TEST_TICKS_H
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Read the test counter instead of a timer */
+#define DOG_GET_TICKS() dog_test_ticks
+
+/*----------------------------------------------------------------------------*/
+/* EXTERNAL DATA                                                              */
+/*----------------------------------------------------------------------------*/
+/** The current time, advanced by the check */
+extern volatile unsigned long dog_test_ticks;
+
+#endif /* DOGM128_TEST_TICKS_H */
+/** @} */ /* DOGM128_test_stub */
@@ -0,0 +1,59 @@
+/*
+ * @file   text_bench.c  <br>
+ * @author Frank Pernice <br>
+ * @date   October 2013  <br>
+ * @brief  Benchmark of text drawn at arbitrary rows. <br>
+ * @defgroup DOGM128_test_text Text Benchmark
+ * @{
+ *
+ * Built once without and once with @b DOG_GLYPH_CACHE_BYTES, so that the two
+ * runs show what the glyph cache saves. A short label is drawn over and over
+ * with dog_draw_string_row() at rows which are not page-aligned, as a value
+ * redrawn in place would be; only the draw target is touched, nothing is
+ * sent.
+ *
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "DOGM128_driver.h"
+
+/*----------------------------------------------------------------------------*/
+/* DEFINES                                                                    */
+/*----------------------------------------------------------------------------*/
+/** Times each label is drawn */
+#define BENCH_ROUNDS 200000
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+
+int main(void)
+{
+  static const char label[] = "12.5 V";
+  struct timespec start, end;
+  double seconds;
+  unsigned long i;
+
+  dog_clear_buffer();
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(i = 0; i < BENCH_ROUNDS; ++i)
+  {
+    dog_draw_string_row(3, 10, label, 0);
+    dog_draw_string_row(21, 70, label, 0);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+  fprintf(stdout, "text: glyph cache of %d bytes, %.1f ns per character\n",
+          DOG_GLYPH_CACHE_BYTES,
+          seconds * 1e9 / (2.0 * BENCH_ROUNDS * (sizeof(label) - 1)));
+  return 0;
+}
+
+/* @} */ /* DOGM128_test_text */